@@ -0,0 +1,87 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <chineseremainder.h>
+#include <modularinverse.h>
+#include <threadpool.h>
+
+namespace ampc {
+
+ChineseRemainder::ChineseRemainder(const std::vector<uint32_t> &moduli) :
+    moduli(moduli),
+    tree(moduli),
+    cofactors(moduli.size())
+{
+    if (moduli.empty()) return;
+
+    std::vector<Integer> upper{Integer(1)};
+    for (size_t l = tree.height() - 1; l > 0; --l) {
+        const std::vector<Integer> &nodes = tree.level(l - 1);
+        const size_t size = nodes.size();
+
+        std::vector<Integer> lower(size);
+        for (size_t s = 0; s < size; s += 2) {
+            if (s + 1 == size) {
+                lower[s] = upper[s / 2];
+                continue;
+            }
+            lower[s] = (upper[s / 2] % nodes[s]) * (nodes[s + 1] % nodes[s]) % nodes[s];
+            lower[s + 1] = (upper[s / 2] % nodes[s + 1]) * (nodes[s] % nodes[s + 1]) % nodes[s + 1];
+        }
+        upper.swap(lower);
+    }
+
+    for (size_t s = 0; s < moduli.size(); ++s) {
+        cofactors[s] = invertModulo(upper[s] % moduli[s], moduli[s]);
+    }
+}
+
+Integer ChineseRemainder::combine(const std::vector<uint32_t> &residues) const {
+    if (residues.size() != moduli.size()) return getModulus();
+    if (moduli.empty()) return Integer(0);
+
+    std::vector<Integer> values(moduli.size());
+    for (size_t s = 0; s < moduli.size(); ++s) {
+        values[s] = Integer((uint32_t)((uint64_t)(residues[s] % moduli[s]) * cofactors[s] % moduli[s]));
+    }
+
+    for (size_t l = 0; l + 1 < tree.height(); ++l) {
+        const std::vector<Integer> &nodes = tree.level(l);
+        const size_t size = nodes.size();
+
+        std::vector<Integer> upper((size + 1) / 2);
+        for (size_t s = 0; s < size; s += 2) {
+            if (s + 1 == size) upper[s / 2] = values[s];
+            else upper[s / 2] = values[s] * nodes[s + 1] + values[s + 1] * nodes[s];
+        }
+        values.swap(upper);
+    }
+
+    return values.front() % getModulus();
+}
+
+void ChineseRemainder::combine(const std::vector<std::vector<uint32_t>> &residues, std::vector<Integer> &results) const {
+    results.resize(residues.size());
+
+    std::vector<std::function<void()>> tasks;
+    for (size_t s = 0; s < residues.size(); ++s) {
+        tasks.push_back([this, &residues, &results, s]() {results[s] = combine(residues[s]);});
+    }
+    ThreadPool::getInstance().run(tasks);
+}
+
+}
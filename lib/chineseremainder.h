@@ -0,0 +1,46 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <producttree.h>
+
+namespace ampc {
+
+/*
+ChineseRemainder reconstructs the Integer in [0, M) with given residues modulo pairwise coprime
+word size moduli, where M is their product. The product tree of the moduli and the cofactors
+((M / m_i)^-1 mod m_i) are computed once, each reconstruction then combines the residues up the
+tree in quasi linear time. combine() expects one residue per modulus, otherwise it returns M,
+which no reconstruction can be.
+*/
+class ChineseRemainder {
+public:
+    ChineseRemainder(const std::vector<uint32_t> &moduli);
+
+    const Integer &getModulus() const {return tree.root();}
+
+    Integer combine(const std::vector<uint32_t> &residues) const;
+    void combine(const std::vector<std::vector<uint32_t>> &residues, std::vector<Integer> &results) const;
+
+private:
+    std::vector<uint32_t> moduli;
+    ProductTree tree;
+    std::vector<uint32_t> cofactors;
+};
+
+}
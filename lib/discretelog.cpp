@@ -0,0 +1,332 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <discretelog.h>
+#include <factorization.h>
+#include <modinteger.h>
+#include <montgomery64.h>
+#include <primes.h>
+#include <randomgenerator.h>
+
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace ampc {
+
+namespace {
+
+constexpr uint64_t BabyStepLimit = (uint64_t)1 << 40;
+constexpr uint32_t EmptySlot = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t WalkMultipliers = 16;
+constexpr uint32_t RhoAttempts = 8;
+
+typedef std::vector<std::pair<Integer, uint32_t>> Factors;
+
+// the multiplicative group modulo an odd prime below 2^64 in Montgomery representation
+class WordGroup {
+public:
+    typedef uint64_t Element;
+
+    WordGroup(const uint64_t p) : m(p) {}
+
+    Element element(const Integer &value) const {return m.toMontgomery(value.toUnsignedLongInt());}
+    Element one() const {return m.one;}
+    Element multiply(const Element a, const Element b) const {return m.multiply(a, b);}
+    Element power(const Element a, const Integer &exponent) const {return m.power(a, exponent.toUnsignedLongInt());}
+    uint64_t key(const Element a) const {return a;}
+
+private:
+    const Montgomery64 m;
+};
+
+class IntegerGroup {
+public:
+    typedef ModInteger Element;
+
+    IntegerGroup(const Integer &p) : context(p) {}
+
+    Element element(const Integer &value) const {return ModInteger(context, value);}
+    Element one() const {return ModInteger(context, Integer(1));}
+    Element multiply(const Element &a, const Element &b) const {return a * b;}
+    Element power(const Element &a, const Integer &exponent) const {return ModInteger(a).power(exponent);}
+
+    // the residues modulo the two largest word size primes, the low limbs alone collide for powers of 2
+    uint64_t key(const Element &a) const {
+        const Integer value = a.toInteger();
+        return (uint64_t)(value % 4294967291u) << 32 | (value % 4294967279u);
+    }
+
+private:
+    const ModContext context;
+};
+
+/*
+Hash table of the baby steps with open addressing and linear probing. Keys and values lie side by
+side and the memory is reserved once for the largest prime factor of the group order.
+*/
+class BabyStepTable {
+public:
+    void reserve(const uint64_t size) {entries.reserve(capacity(size));}
+
+    void reset(const uint64_t size) {
+        entries.assign(capacity(size), Entry{0, EmptySlot});
+        mask = entries.size() - 1;
+    }
+
+    void insert(const uint64_t key, const uint32_t value) {
+        size_t i = hash(key);
+        for (; entries[i].value != EmptySlot; i = (i + 1) & mask) {
+            if (entries[i].key == key) return;
+        }
+        entries[i] = Entry{key, value};
+    }
+
+    uint32_t find(const uint64_t key) const {
+        for (size_t i = hash(key); entries[i].value != EmptySlot; i = (i + 1) & mask) {
+            if (entries[i].key == key) return entries[i].value;
+        }
+        return EmptySlot;
+    }
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint32_t value;
+    };
+
+    std::vector<Entry> entries;
+    size_t mask = 0;
+
+    static size_t capacity(const uint64_t size) {
+        size_t result = 16;
+        while (result < 2 * size) result *= 2;
+        return result;
+    }
+
+    size_t hash(const uint64_t key) const {return (size_t)((key * 0x9E3779B97F4A7C15) >> 32) & mask;}
+};
+
+uint64_t babyStepSize(const uint64_t q) {
+    uint64_t m = (uint64_t)std::sqrt((double)q);
+    while (m * m < q) ++m;
+    return m;
+}
+
+// Solves gamma^x = beta for gamma of prime order q, returns q if there is no solution.
+template <class Group>
+uint64_t babyStepGiantStep(const Group &group, const typename Group::Element &gamma, const typename Group::Element &beta,
+                           const uint64_t q, BabyStepTable &table) {
+    const uint64_t m = babyStepSize(q);
+    table.reset(m);
+
+    typename Group::Element step = group.one();
+    for (uint32_t j = 0; j < m; ++j) {
+        table.insert(group.key(step), j);
+        step = group.multiply(step, gamma);
+    }
+
+    // gamma^-m = gamma^(q - m)
+    const typename Group::Element giant = group.power(gamma, Integer(q - m));
+    typename Group::Element y = beta;
+    for (uint64_t i = 0; i < m; ++i) {
+        const uint32_t j = table.find(group.key(y));
+        if (j != EmptySlot) {
+            const uint64_t x = (i * m + j) % q;
+            if (group.power(gamma, Integer(x)) == beta) return x;
+        }
+        y = group.multiply(y, giant);
+    }
+
+    return q;
+}
+
+/*
+Pollard's rho method with an r-adding walk and Brent's cycle detection. A collision of
+gamma^u beta^v and gamma^u' beta^v' gives x = (u - u') / (v' - v) modulo q.
+*/
+template <class Group>
+uint64_t pollardRhoLog(const Group &group, const typename Group::Element &gamma, const typename Group::Element &beta,
+                       const uint64_t q, RandomGenerator &generator) {
+    typedef typename Group::Element Element;
+
+    const Montgomery64 exponents(q);
+    const uint64_t maxSteps = 16 * babyStepSize(q) + 1024;
+
+    for (uint32_t attempt = 0; attempt < RhoAttempts; ++attempt) {
+        std::vector<Element> multipliers;
+        uint64_t a[WalkMultipliers], b[WalkMultipliers];
+        for (uint32_t r = 0; r < WalkMultipliers; ++r) {
+            a[r] = generator.next() % q;
+            b[r] = generator.next() % q;
+            multipliers.push_back(group.multiply(group.power(gamma, Integer(a[r])), group.power(beta, Integer(b[r]))));
+        }
+
+        uint64_t u = generator.next() % q, v = generator.next() % q;
+        Element y = group.multiply(group.power(gamma, Integer(u)), group.power(beta, Integer(v)));
+        Element saved = y;
+        uint64_t savedU = u, savedV = v;
+
+        for (uint64_t step = 1, length = 1; step < maxSteps; ++step) {
+            const uint32_t r = group.key(y) % WalkMultipliers;
+            y = group.multiply(y, multipliers[r]);
+            u = exponents.add(u, a[r]);
+            v = exponents.add(v, b[r]);
+
+            if (y == saved) {
+                if (v == savedV) break;
+
+                const uint64_t numerator = exponents.toMontgomery(exponents.subtract(u, savedU));
+                const uint64_t denominator = exponents.toMontgomery(exponents.subtract(savedV, v));
+                const uint64_t x = exponents.multiply(exponents.multiply(numerator, exponents.power(denominator, q - 2)), 1);
+                if (group.power(gamma, Integer(x)) == beta) return x;
+                break;
+            }
+
+            if (step == length) {
+                saved = y;
+                savedU = u;
+                savedV = v;
+                length *= 2;
+            }
+        }
+    }
+
+    return q;
+}
+
+/*
+Pohlig-Hellman: for every prime power q^e of the order of g the digits of x modulo q^e are the
+logarithms in the subgroup of order q, the results are combined by the Chinese remainder theorem.
+*/
+template <class Group>
+bool pohligHellman(const Group &group, const Integer &g, const Integer &h, const Integer &n, const Factors &factors, Integer &x) {
+    typedef typename Group::Element Element;
+
+    const Element one = group.one(), base = group.element(g), target = group.element(h);
+
+    Integer order = n;
+    for (const auto &factor : factors) {
+        for (uint32_t k = 0; k < factor.second && group.power(base, order / factor.first) == one; ++k) order /= factor.first;
+    }
+    if (group.power(target, order) != one) return false;
+
+    BabyStepTable table;
+    for (const auto &factor : factors) {
+        if (factor.first.isUnsigned64Bit() && factor.first.toUnsignedLongInt() <= BabyStepLimit) {
+            table.reserve(babyStepSize(factor.first.toUnsignedLongInt()));
+        }
+    }
+
+    RandomGenerator generator;
+    Integer modulus(1);
+    x.set(0);
+
+    for (const auto &factor : factors) {
+        const Integer &q = factor.first;
+        Integer power(1);
+        uint32_t e = 0;
+        while ((order % (power * q)).isZero()) {
+            power *= q;
+            ++e;
+        }
+        if (e == 0) continue;
+        if (!q.isUnsigned64Bit()) return false;
+
+        const uint64_t prime = q.toUnsignedLongInt();
+        const Integer cofactor = order / power;
+        const Element baseQ = group.power(base, cofactor), targetQ = group.power(target, cofactor);
+        const Element gamma = group.power(baseQ, power / q);
+
+        Integer digits(0), weight(1);
+        for (uint32_t k = 0; k < e; ++k) {
+            // (baseQ^-digits targetQ)^(q^(e - 1 - k)) = gamma^d
+            const Element t = group.power(group.multiply(group.power(baseQ, power - digits), targetQ), power / (weight * q));
+            const uint64_t d = prime <= BabyStepLimit ? babyStepGiantStep(group, gamma, t, prime, table) : pollardRhoLog(group, gamma, t, prime, generator);
+            if (d == prime) return false;
+
+            digits += weight * Integer(d);
+            weight *= q;
+        }
+
+        Integer inverse = modulus;
+        inverse.invertModulo(power);
+        Integer c = (digits - x) * inverse % power;
+        if (!c.isPositive()) c += power;
+
+        x += modulus * c;
+        modulus *= power;
+    }
+
+    return true;
+}
+
+}
+
+uint32_t DiscreteLogarithm::discreteLog(const uint32_t g, const uint32_t h, const uint32_t p) {
+    return (uint32_t)discreteLog((uint64_t)g, (uint64_t)h, (uint64_t)p);
+}
+
+uint64_t DiscreteLogarithm::discreteLog(const uint64_t g, const uint64_t h, const uint64_t p) {
+    if (p < 2) return p;
+
+    const uint64_t a = g % p, b = h % p;
+    if (b == 1) return 0;
+    if (a == 0) return b == 0 ? 1 : p;
+    if (p == 2) return p;
+
+    Factors factors;
+    if (p - 1 <= MaxLimit) {
+        std::vector<uint32_t> primes;
+        Primes::getPrimeFactorsWithMultiplicity((uint32_t)(p - 1), primes);
+        for (const uint32_t q : primes) {
+            if (!factors.empty() && factors.back().first == Integer(q)) ++factors.back().second;
+            else factors.push_back(std::make_pair(Integer(q), 1));
+        }
+    }
+    else Factorization::factor(Integer(p - 1), factors);
+
+    Integer x;
+    if (!pohligHellman(WordGroup(p), Integer(a), Integer(b), Integer(p - 1), factors, x)) return p;
+    return x.toUnsignedLongInt();
+}
+
+Integer DiscreteLogarithm::discreteLog(const Integer &g, const Integer &h, const Integer &p) {
+    Integer modulus = p;
+    modulus.abs();
+    if (modulus.isUnsigned64Bit()) {
+        if (modulus < Integer(2)) return modulus;
+
+        const ModContext context(modulus);
+        return Integer(discreteLog(context.reduce(g).toUnsignedLongInt(), context.reduce(h).toUnsignedLongInt(), modulus.toUnsignedLongInt()));
+    }
+
+    const IntegerGroup group(modulus);
+    const ModInteger a = group.element(g), b = group.element(h);
+    if (b == group.one()) return Integer(0);
+    if (a.isZero()) return b.isZero() ? Integer(1) : modulus;
+
+    Factors factors;
+    Factorization::factor(modulus - 1, factors);
+
+    Integer x;
+    if (!pohligHellman(group, g, h, modulus - 1, factors, x)) return modulus;
+    return x;
+}
+
+}
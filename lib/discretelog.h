@@ -0,0 +1,38 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <integer.h>
+
+namespace ampc {
+
+/*
+DiscreteLogarithm solves g^x = h modulo a prime p. The order of g is computed from the
+factorization of p - 1 and the problem is split by Pohlig-Hellman into problems in groups of
+prime order q, which are solved by baby-step giant-step for q up to 2^40 and by Pollard's rho
+method beyond. The smallest x >= 0 is returned, or p, if there is no solution or the order of g
+has a prime factor above 2^64.
+*/
+class DiscreteLogarithm {
+public:
+    static uint32_t discreteLog(const uint32_t g, const uint32_t h, const uint32_t p);
+    static uint64_t discreteLog(const uint64_t g, const uint64_t h, const uint64_t p);
+    static Integer discreteLog(const Integer &g, const Integer &h, const Integer &p);
+};
+
+}
@@ -0,0 +1,409 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <factorization.h>
+#include <modinteger.h>
+#include <montgomery64.h>
+#include <primes.h>
+#include <quadraticsieve.h>
+#include <randomgenerator.h>
+#include <threadpool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace ampc {
+
+namespace {
+
+constexpr uint32_t RhoBatch = 128;
+constexpr uint64_t RhoSteps = 1 << 18;
+
+// B1 and the number of curves to find factors of about 15, 20, 25, 30 and 35 digits
+constexpr uint32_t EcmBounds[] = {2000, 11000, 50000, 250000, 1000000};
+constexpr uint32_t EcmCurves[] = {25, 90, 300, 700, 1800};
+constexpr uint32_t EcmMaxLevels = sizeof(EcmBounds) / sizeof(EcmBounds[0]);
+constexpr uint32_t EcmDefaultLevels = 2;
+
+constexpr uint32_t SieveMinBits = 50;
+// about 65 digits, the measured range of the quadratic sieve
+constexpr uint32_t SieveMaxBits = 216;
+
+uint64_t gcd64(uint64_t a, uint64_t b) {
+    while (b != 0) {
+        const uint64_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+// deterministic for all n < 2^64
+bool isPrime64(const uint64_t n) {
+    if (n < 2 || n % 2 == 0) return n == 2;
+
+    const Montgomery64 m(n);
+    uint64_t d = n - 1;
+    uint32_t powerOfTwo = 0;
+    for (; d % 2 == 0; d /= 2) ++powerOfTwo;
+
+    const uint64_t minusOne = m.subtract(0, m.one);
+    for (const uint64_t base : {2, 325, 9375, 28178, 450775, 9780504, 1795265022}) {
+        if (base % n == 0) continue;
+
+        uint64_t x = m.power(m.toMontgomery(base), d);
+        if (x == m.one || x == minusOne) continue;
+
+        uint32_t j = 1;
+        for (; j < powerOfTwo; ++j) {
+            x = m.multiply(x, x);
+            if (x == minusOne) break;
+        }
+        if (j == powerOfTwo) return false;
+    }
+    return true;
+}
+
+uint64_t pollardRho64(const uint64_t n, RandomGenerator &generator, const uint64_t steps) {
+    const Montgomery64 m(n);
+
+    for (uint32_t attempt = 0; attempt < 64; ++attempt) {
+        const uint64_t c = m.toMontgomery(1 + generator.next() % (n - 1));
+        uint64_t x = 0, y = m.toMontgomery(generator.next()), saved = 0, q = m.one, g = 1;
+
+        for (uint64_t r = 1; g == 1; r *= 2) {
+            if (r > steps) return n;
+
+            x = y;
+            for (uint64_t i = 0; i < r; ++i) y = m.add(m.multiply(y, y), c);
+
+            for (uint64_t k = 0; k < r && g == 1; k += RhoBatch) {
+                saved = y;
+                for (uint64_t i = 0; i < std::min<uint64_t>(RhoBatch, r - k); ++i) {
+                    y = m.add(m.multiply(y, y), c);
+                    q = m.multiply(q, m.subtract(x, y));
+                }
+                g = gcd64(q, n);
+            }
+        }
+
+        if (g == n) {
+            do {
+                saved = m.add(m.multiply(saved, saved), c);
+                g = gcd64(m.subtract(x, saved), n);
+            } while (g == 1);
+        }
+
+        if (g != n) return g;
+    }
+
+    return n;
+}
+
+struct CurvePoint {
+    ModInteger x;
+    ModInteger z;
+};
+
+/*
+The Montgomery curve B y^2 = x^3 + A x^2 + x in the projective x-only representation (X : Z),
+in which only a24 = (A + 2) / 4 enters the formulas.
+*/
+class MontgomeryCurve {
+public:
+    MontgomeryCurve(const ModInteger &a24) : a24(a24) {}
+
+    CurvePoint duplicate(const CurvePoint &p) const {
+        const ModInteger sum = p.x + p.z, difference = p.x - p.z;
+        const ModInteger t1 = sum * sum, t2 = difference * difference, t3 = t1 - t2;
+        return CurvePoint{t1 * t2, t3 * (t2 + a24 * t3)};
+    }
+
+    // p + q, given p - q
+    CurvePoint add(const CurvePoint &p, const CurvePoint &q, const CurvePoint &difference) const {
+        const ModInteger u = (p.x - p.z) * (q.x + q.z), v = (p.x + p.z) * (q.x - q.z);
+        const ModInteger sum = u + v, delta = u - v;
+        return CurvePoint{difference.z * (sum * sum), difference.x * (delta * delta)};
+    }
+
+    CurvePoint multiply(const CurvePoint &p, const uint64_t k) const {
+        CurvePoint r0 = p, r1 = duplicate(p);
+
+        uint64_t bit = (uint64_t)1 << 63;
+        while (bit > k) bit >>= 1;
+        for (bit >>= 1; bit > 0; bit >>= 1) {
+            if (k & bit) {
+                r0 = add(r1, r0, p);
+                r1 = duplicate(r1);
+            }
+            else {
+                r1 = add(r0, r1, p);
+                r0 = duplicate(r0);
+            }
+        }
+        return r0;
+    }
+
+private:
+    ModInteger a24;
+};
+
+constexpr uint32_t GiantStep = 210;
+
+/*
+Runs one curve with Suyama's parametrization by sigma. Stage 1 multiplies the start point Q by
+all prime powers up to b1. Stage 2 accumulates X(m D Q) Z(j Q) - X(j Q) Z(m D Q) for the primes
+p = m D +- j in (b1, b2]. Returns the gcd with n, which is 1 or n if the curve fails.
+*/
+Integer runCurve(const ModContext &context, const Integer &sigma, const std::vector<uint32_t> &primes, const uint32_t b1, const uint64_t b2, const std::atomic<bool> &found) {
+    const Integer &n = context.getModulus();
+
+    const ModInteger s(context, sigma);
+    const ModInteger u = s * s - ModInteger(context, Integer(5)), v = s * ModInteger(context, Integer(4));
+    const ModInteger u3 = u * u * u, difference = v - u;
+
+    ModInteger denominator = u3 * v * ModInteger(context, Integer(16));
+    const Integer g = Integer::gcd(denominator.toInteger(), n);
+    if (g != 1) return g;
+
+    const MontgomeryCurve curve(difference * difference * difference * (u * ModInteger(context, Integer(3)) + v) * denominator.invert());
+    CurvePoint q{u3, v * v * v};
+
+    for (const uint32_t p : primes) {
+        if (p > b1) break;
+        if (found) return Integer(1);
+
+        uint64_t power = p;
+        while (power * p <= b1) power *= p;
+        q = curve.multiply(q, power);
+    }
+
+    const Integer result = Integer::gcd(q.z.toInteger(), n);
+    if (result != 1 || b2 <= b1) return result;
+
+    // baby[k] = (2k + 1) Q for the odd j = 2k + 1 <= D / 2
+    const CurvePoint q2 = curve.duplicate(q);
+    std::vector<CurvePoint> baby(GiantStep / 4 + 1, q);
+    baby[1] = curve.add(q2, q, q);
+    for (size_t k = 2; k < baby.size(); ++k) baby[k] = curve.add(baby[k - 1], q2, baby[k - 2]);
+
+    // the primes p <= D / 2 have no giant step m >= 1, Z(p Q) of baby[p / 2] detects p Q = 0 directly
+    ModInteger accumulator(context, Integer(1));
+    auto p = std::upper_bound(primes.begin(), primes.end(), b1);
+    for (; p != primes.end() && *p <= b2 && *p <= GiantStep / 2; ++p) accumulator *= baby[*p / 2].z;
+
+    // current = m D Q, next = (m + 1) D Q
+    const CurvePoint step = curve.multiply(q, GiantStep);
+    uint64_t m = std::max<uint64_t>(1, ((uint64_t)b1 + 1 + GiantStep / 2) / GiantStep);
+    CurvePoint current = curve.multiply(q, m * GiantStep), next = curve.multiply(q, (m + 1) * GiantStep);
+
+    for (; p != primes.end() && *p <= b2; ++p) {
+        const uint64_t target = (*p + GiantStep / 2) / GiantStep;
+        while (m < target) {
+            if (found) return Integer(1);
+
+            const CurvePoint following = curve.add(next, step, current);
+            current = next;
+            next = following;
+            ++m;
+        }
+
+        const uint64_t j = *p > m * GiantStep ? *p - m * GiantStep : m * GiantStep - *p;
+        const CurvePoint &b = baby[j / 2];
+        accumulator *= current.x * b.z - b.x * current.z;
+    }
+
+    return Integer::gcd(accumulator.toInteger(), n);
+}
+
+}
+
+uint32_t Factorization::levels = EcmDefaultLevels;
+
+void Factorization::setEcmLevels(const uint32_t levels) {
+    Factorization::levels = std::min(levels, EcmMaxLevels);
+}
+
+void Factorization::factor(const Integer &n, std::vector<std::pair<Integer, uint32_t>> &factors) {
+    factors.clear();
+
+    Integer rest = n;
+    rest.abs();
+    if (rest.isZero()) return;
+
+    std::vector<uint32_t> smallPrimes;
+    Primes::getPrimes(std::numeric_limits<uint16_t>::max(), smallPrimes);
+    for (const uint32_t p : smallPrimes) {
+        if (rest < Integer(p) * p) break;
+
+        std::pair<Integer, uint32_t> division = rest.divideWithRest(p);
+        if (division.second != 0) continue;
+
+        uint32_t multiplicity = 0;
+        while (division.second == 0) {
+            rest = division.first;
+            ++multiplicity;
+            division = rest.divideWithRest(p);
+        }
+        factors.push_back(std::make_pair(Integer(p), multiplicity));
+    }
+
+    if (rest == 1) return;
+
+    std::vector<Integer> primes;
+    split(rest, primes);
+    std::sort(primes.begin(), primes.end());
+
+    for (const Integer &p : primes) {
+        if (!factors.empty() && factors.back().first == p) ++factors.back().second;
+        else factors.push_back(std::make_pair(p, 1));
+    }
+}
+
+/*
+Runs the given number of curves on the ThreadPool, all curves stop as soon as one of them has
+found a factor. Returns a proper factor of n or n itself.
+*/
+Integer Factorization::ecm(const Integer &n, const uint32_t b1, uint64_t b2, const uint32_t curves, const uint64_t seed) {
+    if (n % 2 == 0) return n == 2 ? n : Integer(2);
+    if (b2 == 0) b2 = 100 * (uint64_t)b1;
+
+    std::vector<uint32_t> primes;
+    Primes::getPrimes((uint32_t)std::min<uint64_t>(std::max<uint64_t>(b1, b2), MaxLimit), primes);
+
+    const ModContext context(n);
+    std::atomic<bool> found(false);
+    std::mutex mutex;
+    Integer factor = n;
+
+    std::vector<std::function<void()>> tasks;
+    for (uint32_t c = 0; c < curves; ++c) {
+        tasks.push_back([&, c]() {
+            if (found) return;
+
+            RandomGenerator generator(seed + c);
+            const Integer g = runCurve(context, generator.below(n - 7) + 6, primes, b1, b2, found);
+            if (g == 1 || g == n) return;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!found) {
+                factor = g;
+                found = true;
+            }
+        });
+    }
+    ThreadPool::getInstance().run(tasks);
+
+    return factor;
+}
+
+Integer Factorization::quadraticSieve(const Integer &n, const uint64_t seed) {
+    if (n.bitLength() < SieveMinBits) return pollardRho(n, seed);
+    if (n.bitLength() > SieveMaxBits) return n;
+    return QuadraticSieve(n, seed).factor();
+}
+
+/*
+Brent's cycle detection on x -> x^2 + c in Montgomery arithmetic. The differences of RhoBatch
+steps are multiplied before one gcd is taken, if this gcd is n the last batch is repeated step
+by step. Returns a proper factor of the odd composite n, or n if all attempts fail or the cycle
+length exceeds steps.
+*/
+Integer Factorization::pollardRho(const Integer &n, const uint64_t seed, const uint64_t steps) {
+    if (n < 4) return n;
+    if (n % 2 == 0) return Integer(2);
+
+    RandomGenerator generator(seed);
+    if (n.isUnsigned64Bit()) return Integer(pollardRho64(n.toUnsignedLongInt(), generator, steps));
+
+    const ModContext context(n);
+
+    for (uint32_t attempt = 0; attempt < 64; ++attempt) {
+        const ModInteger c(context, generator.below(n - 1) + 1);
+        ModInteger x(context), y(context, generator.below(n)), saved(context), q(context, Integer(1));
+        Integer g(1);
+
+        for (uint64_t r = 1; g == 1; r *= 2) {
+            if (r > steps) return n;
+
+            x = y;
+            for (uint64_t i = 0; i < r; ++i) y = y * y + c;
+
+            for (uint64_t k = 0; k < r && g == 1; k += RhoBatch) {
+                saved = y;
+                for (uint64_t i = 0; i < std::min<uint64_t>(RhoBatch, r - k); ++i) {
+                    y = y * y + c;
+                    q *= x - y;
+                }
+                g = Integer::gcd(q.toInteger(), n);
+            }
+        }
+
+        if (g == n) {
+            do {
+                saved = saved * saved + c;
+                g = Integer::gcd((x - saved).toInteger(), n);
+            } while (g == 1);
+        }
+
+        if (g != n) return g;
+    }
+
+    return n;
+}
+
+void Factorization::split(const Integer &n, std::vector<Integer> &primes) {
+    if (n.isUnsigned64Bit() ? isPrime64(n.toUnsignedLongInt()) : n.millerRabinPrimalityTest()) {
+        primes.push_back(n);
+        return;
+    }
+
+    // All prime factors exceed 2^16, so n is at most a (bits / 16)-th power.
+    const uint32_t maxExponent = (uint32_t)(n.bitLength() / 16);
+    for (uint32_t e = maxExponent; e >= 2; --e) {
+        Integer root = n;
+        root.iroot(e);
+        Integer power = root;
+        power.power(Integer(e));
+        if (power == n) {
+            std::vector<Integer> rootPrimes;
+            split(root, rootPrimes);
+            for (uint32_t i = 0; i < e; ++i) primes.insert(primes.end(), rootPrimes.begin(), rootPrimes.end());
+            return;
+        }
+    }
+
+    // Rho finds the small factors quickly, larger ones are left to ECM with growing bounds.
+    Integer d = n.isUnsigned64Bit() ? pollardRho(n, n.toUnsignedInt()) : pollardRho(n, n.toUnsignedInt(), RhoSteps);
+    const bool sieve = n.bitLength() <= SieveMaxBits;
+    for (uint32_t level = 0; d == n && level < levels; ++level) {
+        if (level == 1 && sieve) d = quadraticSieve(n, n.toUnsignedInt());
+        else d = ecm(n, EcmBounds[level], 0, EcmCurves[level], n.toUnsignedInt());
+    }
+    if (d == n && levels < 2 && sieve) d = quadraticSieve(n, n.toUnsignedInt());
+
+    if (d == n) {
+        primes.push_back(n);
+        return;
+    }
+
+    split(d, primes);
+    split(n / d, primes);
+}
+
+}
@@ -0,0 +1,56 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <integer.h>
+
+#include <utility>
+#include <vector>
+
+namespace ampc {
+
+/*
+Factorization splits Integers into primes. factor() removes the primes of the Primes table by
+trial division, detects perfect powers and splits the remaining composites with Brent's variant
+of Pollard's rho method and the elliptic curve method. Composites of up to 65 digits, which
+resist a first round of ECM, go to the quadratic sieve. This goes on until every factor passes
+the Miller-Rabin-Test, a composite, which resists all methods, is returned as a factor.
+The number of ECM levels (B1 = 2000, 11000, 50000, 250000, 10^6 for factors of about 15 to 35
+digits) bounds the effort for such a composite. On one thread and for 250 bits the default of
+two levels costs about 20 seconds, three levels about 5 minutes and all five levels many hours.
+quadraticSieve() takes up to 216 bits (65 digits) and returns larger n unchanged, the matrix step
+is dense Gaussian elimination and 55 digits already take seconds.
+*/
+class Factorization {
+public:
+    static void factor(const Integer &n, std::vector<std::pair<Integer, uint32_t>> &factors);
+
+    static void setEcmLevels(const uint32_t levels);
+    static uint32_t ecmLevels() {return levels;}
+
+    static Integer pollardRho(const Integer &n, const uint64_t seed = 0, const uint64_t steps = std::numeric_limits<uint64_t>::max());
+    static Integer ecm(const Integer &n, const uint32_t b1, uint64_t b2 = 0, const uint32_t curves = 100, const uint64_t seed = 0);
+    static Integer quadraticSieve(const Integer &n, const uint64_t seed = 0);
+
+private:
+    static uint32_t levels;
+
+    static void split(const Integer &n, std::vector<Integer> &primes);
+};
+
+}
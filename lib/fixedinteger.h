@@ -0,0 +1,322 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <integer.h>
+
+#include <stdexcept>
+#include <utility>
+
+namespace ampc {
+
+/*
+FixedInteger is an Integer with a capacity of Limbs 32 bit words, which can be evaluated at compile
+time. Overflows and invalid input throw, so inside of a constant expression they end up as compile
+errors.
+*/
+template<size_t Limbs>
+class FixedInteger {
+    static_assert(Limbs > 0, "FixedInteger needs at least one limb");
+
+public:
+    constexpr FixedInteger() : positive(true), absoluteValue{} {}
+    constexpr FixedInteger(uint32_t i) : positive(true), absoluteValue{} {absoluteValue[0] = i;}
+    constexpr FixedInteger(int32_t i) : positive(i >= 0), absoluteValue{} {absoluteValue[0] = i >= 0 ? (uint32_t)i : 0 - (uint32_t)i;}
+    constexpr FixedInteger(uint64_t i) : positive(true), absoluteValue{} {setUnsigned(i);}
+    constexpr FixedInteger(int64_t i) : positive(i >= 0), absoluteValue{} {setUnsigned(i >= 0 ? (uint64_t)i : 0 - (uint64_t)i);}
+    constexpr FixedInteger(const char *str) : positive(true), absoluteValue{} {set(str);}
+
+    constexpr void set(const char *str);
+
+    constexpr uint32_t limb(const size_t index) const {return absoluteValue[index];}
+    constexpr size_t size() const;
+
+    Integer toInteger() const;
+
+    constexpr size_t print(char *str, const size_t capacity) const;
+    void print(std::string &str) const;
+
+    constexpr bool isZero() const {return size() == 0;}
+    constexpr bool isPositive() const {return positive || isZero();}
+
+    constexpr bool operator >(const FixedInteger &rhs) const;
+    constexpr bool operator >=(const FixedInteger &rhs) const {return !(rhs > *this);}
+    constexpr bool operator <(const FixedInteger &rhs) const {return rhs > *this;}
+    constexpr bool operator <=(const FixedInteger &rhs) const {return !(*this > rhs);}
+    constexpr bool operator ==(const FixedInteger &rhs) const;
+    constexpr bool operator !=(const FixedInteger &rhs) const {return !(*this == rhs);}
+
+    constexpr FixedInteger operator -() const;
+    constexpr FixedInteger operator +(const FixedInteger &rhs) const;
+    constexpr FixedInteger operator -(const FixedInteger &rhs) const {return *this + (-rhs);}
+    constexpr FixedInteger operator *(const FixedInteger &rhs) const;
+    constexpr FixedInteger operator /(const FixedInteger &divisor) const {return divideWithRest(divisor).first;}
+    constexpr FixedInteger operator %(const FixedInteger &rhs) const;
+
+    constexpr std::pair<FixedInteger, FixedInteger> divideWithRest(const FixedInteger &rhs) const;
+
+    constexpr FixedInteger &operator +=(const FixedInteger &rhs) {return *this = *this + rhs;}
+    constexpr FixedInteger &operator -=(const FixedInteger &rhs) {return *this = *this - rhs;}
+    constexpr FixedInteger &operator *=(const FixedInteger &rhs) {return *this = *this * rhs;}
+    constexpr FixedInteger &operator /=(const FixedInteger &rhs) {return *this = *this / rhs;}
+    constexpr FixedInteger &operator %=(const FixedInteger &rhs) {return *this = *this % rhs;}
+
+private:
+    bool positive;
+    uint32_t absoluteValue[Limbs];
+
+    constexpr void setUnsigned(uint64_t i);
+
+    static constexpr bool isAbsoluteValueLarger(const uint32_t *lhs, const uint32_t *rhs);
+    static constexpr void addAbsValues(const uint32_t *lhs, const uint32_t *rhs, uint32_t *result);
+    static constexpr void subtractAbsValues(const uint32_t *larger, const uint32_t *smaller, uint32_t *result);
+    static constexpr void multiplyByInt(uint32_t *value, const uint32_t i, const uint32_t summand);
+    static constexpr uint32_t divideByInt(uint32_t *value, const uint32_t i);
+};
+
+template<size_t Limbs>
+constexpr void FixedInteger<Limbs>::set(const char *str) {
+    for (size_t s = 0; s < Limbs; ++s) absoluteValue[s] = 0;
+
+    bool sign = true;
+    if (*str == '-') {
+        sign = false;
+        ++str;
+    }
+    if (*str == '\0') throw std::invalid_argument("FixedInteger: empty number");
+
+    for (; *str != '\0'; ++str) {
+        if (*str < '0' || *str > '9') throw std::invalid_argument("FixedInteger: invalid digit");
+        multiplyByInt(absoluteValue, 10, (uint32_t)(*str - '0'));
+    }
+    positive = sign;
+}
+
+template<size_t Limbs>
+constexpr size_t FixedInteger<Limbs>::size() const {
+    size_t size = Limbs;
+    while (size > 0 && absoluteValue[size - 1] == 0) --size;
+    return size;
+}
+
+template<size_t Limbs>
+Integer FixedInteger<Limbs>::toInteger() const {
+    Integer result;
+    const Integer basis(Basis);
+    for (size_t s = size(); s > 0; --s) {
+        result = result * basis + Integer(absoluteValue[s - 1]);
+    }
+    return isPositive() ? result : -result;
+}
+
+template<size_t Limbs>
+constexpr size_t FixedInteger<Limbs>::print(char *str, const size_t capacity) const {
+    uint32_t local[Limbs] = {};
+    for (size_t s = 0; s < Limbs; ++s) local[s] = absoluteValue[s];
+
+    char digits[Limbs * 10 + 1] = {};
+    size_t count = 0;
+    bool nonZero = true;
+    while (nonZero) {
+        digits[count++] = (char)('0' + divideByInt(local, 10));
+
+        nonZero = false;
+        for (size_t s = 0; s < Limbs; ++s) nonZero = nonZero || local[s] != 0;
+    }
+
+    const bool negative = !isPositive();
+    const size_t length = count + (negative ? 1 : 0);
+    if (length + 1 > capacity) throw std::length_error("FixedInteger: print buffer too small");
+
+    size_t index = 0;
+    if (negative) str[index++] = '-';
+    while (count > 0) str[index++] = digits[--count];
+    str[index] = '\0';
+
+    return length;
+}
+
+template<size_t Limbs>
+void FixedInteger<Limbs>::print(std::string &str) const {
+    char buffer[Limbs * 10 + 2] = {};
+    str.assign(buffer, print(buffer, sizeof(buffer)));
+}
+
+template<size_t Limbs>
+constexpr bool FixedInteger<Limbs>::operator >(const FixedInteger &rhs) const {
+    if (!isPositive() && rhs.isPositive()) return false;
+    if (isPositive() && !rhs.isPositive()) return true;
+
+    return isPositive() ? isAbsoluteValueLarger(absoluteValue, rhs.absoluteValue)
+                        : isAbsoluteValueLarger(rhs.absoluteValue, absoluteValue);
+}
+
+template<size_t Limbs>
+constexpr bool FixedInteger<Limbs>::operator ==(const FixedInteger &rhs) const {
+    if (isPositive() != rhs.isPositive()) return false;
+    for (size_t s = 0; s < Limbs; ++s) {
+        if (absoluteValue[s] != rhs.absoluteValue[s]) return false;
+    }
+    return true;
+}
+
+template<size_t Limbs>
+constexpr FixedInteger<Limbs> FixedInteger<Limbs>::operator -() const {
+    FixedInteger result(*this);
+    result.positive = !positive || isZero();
+    return result;
+}
+
+template<size_t Limbs>
+constexpr FixedInteger<Limbs> FixedInteger<Limbs>::operator +(const FixedInteger &rhs) const {
+    FixedInteger result;
+    if (isPositive() == rhs.isPositive()) {
+        result.positive = isPositive();
+        addAbsValues(absoluteValue, rhs.absoluteValue, result.absoluteValue);
+    }
+    else if (isAbsoluteValueLarger(rhs.absoluteValue, absoluteValue)) {
+        result.positive = rhs.isPositive();
+        subtractAbsValues(rhs.absoluteValue, absoluteValue, result.absoluteValue);
+    }
+    else {
+        result.positive = isPositive();
+        subtractAbsValues(absoluteValue, rhs.absoluteValue, result.absoluteValue);
+    }
+    if (result.isZero()) result.positive = true;
+    return result;
+}
+
+template<size_t Limbs>
+constexpr FixedInteger<Limbs> FixedInteger<Limbs>::operator *(const FixedInteger &rhs) const {
+    uint32_t product[2 * Limbs] = {};
+
+    for (size_t s = 0; s < Limbs; ++s) {
+        uint64_t overflow = 0;
+        for (size_t t = 0; t < Limbs; ++t) {
+            const uint64_t sum = (uint64_t)absoluteValue[s] * rhs.absoluteValue[t] + product[s + t] + overflow;
+            product[s + t] = (uint32_t)sum;
+            overflow = sum >> 32;
+        }
+        product[s + Limbs] = (uint32_t)overflow;
+    }
+
+    FixedInteger result;
+    for (size_t s = 0; s < Limbs; ++s) {
+        if (product[Limbs + s] != 0) throw std::overflow_error("FixedInteger: product exceeds capacity");
+        result.absoluteValue[s] = product[s];
+    }
+    result.positive = isPositive() == rhs.isPositive() || result.isZero();
+    return result;
+}
+
+template<size_t Limbs>
+constexpr FixedInteger<Limbs> FixedInteger<Limbs>::operator %(const FixedInteger &rhs) const {
+    return divideWithRest(rhs).second;
+}
+
+template<size_t Limbs>
+constexpr std::pair<FixedInteger<Limbs>, FixedInteger<Limbs>> FixedInteger<Limbs>::divideWithRest(const FixedInteger &rhs) const {
+    if (rhs.isZero()) throw std::domain_error("FixedInteger: division by zero");
+
+    FixedInteger quotient, rest;
+
+    for (size_t bit = 32 * Limbs; bit > 0; --bit) {
+        const size_t s = (bit - 1) / 32;
+
+        uint32_t carry = (absoluteValue[s] >> ((bit - 1) % 32)) & 1;
+        for (size_t t = 0; t < Limbs; ++t) {
+            const uint32_t next = rest.absoluteValue[t] >> 31;
+            rest.absoluteValue[t] = (rest.absoluteValue[t] << 1) | carry;
+            carry = next;
+        }
+
+        if (carry != 0 || !isAbsoluteValueLarger(rhs.absoluteValue, rest.absoluteValue)) {
+            subtractAbsValues(rest.absoluteValue, rhs.absoluteValue, rest.absoluteValue);
+            quotient.absoluteValue[s] |= (uint32_t)1 << ((bit - 1) % 32);
+        }
+    }
+
+    quotient.positive = isPositive() == rhs.isPositive() || quotient.isZero();
+
+    if (!isPositive() && !rest.isZero()) subtractAbsValues(rhs.absoluteValue, rest.absoluteValue, rest.absoluteValue);
+
+    return std::pair<FixedInteger, FixedInteger>(quotient, rest);
+}
+
+template<size_t Limbs>
+constexpr void FixedInteger<Limbs>::setUnsigned(uint64_t i) {
+    absoluteValue[0] = (uint32_t)i;
+    if (i >> 32 == 0) return;
+
+    if (Limbs == 1) throw std::overflow_error("FixedInteger: value exceeds capacity");
+    absoluteValue[Limbs > 1 ? 1 : 0] = (uint32_t)(i >> 32);
+}
+
+template<size_t Limbs>
+constexpr bool FixedInteger<Limbs>::isAbsoluteValueLarger(const uint32_t *lhs, const uint32_t *rhs) {
+    for (size_t s = Limbs; s > 0; --s) {
+        if (lhs[s - 1] > rhs[s - 1]) return true;
+        if (lhs[s - 1] < rhs[s - 1]) return false;
+    }
+    return false;
+}
+
+template<size_t Limbs>
+constexpr void FixedInteger<Limbs>::addAbsValues(const uint32_t *lhs, const uint32_t *rhs, uint32_t *result) {
+    uint64_t overflow = 0;
+    for (size_t s = 0; s < Limbs; ++s) {
+        const uint64_t sum = overflow + lhs[s] + rhs[s];
+        result[s] = (uint32_t)sum;
+        overflow = sum >> 32;
+    }
+    if (overflow != 0) throw std::overflow_error("FixedInteger: sum exceeds capacity");
+}
+
+template<size_t Limbs>
+constexpr void FixedInteger<Limbs>::subtractAbsValues(const uint32_t *larger, const uint32_t *smaller, uint32_t *result) {
+    uint64_t overflow = 0;
+    for (size_t s = 0; s < Limbs; ++s) {
+        const uint64_t sum = Basis + larger[s] - smaller[s] - overflow;
+        result[s] = (uint32_t)sum;
+        overflow = 1 - (sum >> 32);
+    }
+}
+
+template<size_t Limbs>
+constexpr void FixedInteger<Limbs>::multiplyByInt(uint32_t *value, const uint32_t i, const uint32_t summand) {
+    uint64_t overflow = summand;
+    for (size_t s = 0; s < Limbs; ++s) {
+        const uint64_t sum = (uint64_t)value[s] * i + overflow;
+        value[s] = (uint32_t)sum;
+        overflow = sum >> 32;
+    }
+    if (overflow != 0) throw std::overflow_error("FixedInteger: value exceeds capacity");
+}
+
+template<size_t Limbs>
+constexpr uint32_t FixedInteger<Limbs>::divideByInt(uint32_t *value, const uint32_t i) {
+    uint64_t overflow = 0;
+    for (size_t s = Limbs; s > 0; --s) {
+        const uint64_t sum = (overflow << 32) + value[s - 1];
+        value[s - 1] = (uint32_t)(sum / i);
+        overflow = sum % i;
+    }
+    return (uint32_t)overflow;
+}
+
+}
@@ -16,10 +16,343 @@ along with ampclib; if not, see http://www.gnu.org/licenses.
 */
 
 #include <integer.h>
+#include <factorization.h>
+#include <modinteger.h>
 #include <primes.h>
+#include <producttree.h>
+#include <randomgenerator.h>
+#include <threadpool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 
 namespace ampc {
 
+namespace {
+
+constexpr size_t KaratsubaThreshold = 32;
+constexpr size_t RemainderLanes = 8;
+constexpr size_t ParallelThreshold = 2048;
+
+uint32_t addLimbs(uint32_t *result, const size_t resultSize, const uint32_t *summand, const size_t summandSize) {
+    uint64_t overflow = 0;
+    size_t s = 0;
+    for (; s < summandSize; ++s) {
+        const uint64_t sum = overflow + result[s] + summand[s];
+        result[s] = sum % Basis;
+        overflow = sum / Basis;
+    }
+    for (; s < resultSize && overflow > 0; ++s) {
+        const uint64_t sum = overflow + result[s];
+        result[s] = sum % Basis;
+        overflow = sum / Basis;
+    }
+    return (uint32_t)overflow;
+}
+
+void subtractLimbs(uint32_t *result, const size_t resultSize, const uint32_t *subtrahend, const size_t subtrahendSize) {
+    uint64_t overflow = 0;
+    size_t s = 0;
+    for (; s < subtrahendSize; ++s) {
+        const uint64_t sum = Basis + result[s] - subtrahend[s] - overflow;
+        result[s] = sum % Basis;
+        overflow = 1 - sum / Basis;
+    }
+    for (; s < resultSize && overflow > 0; ++s) {
+        const uint64_t sum = Basis + result[s] - overflow;
+        result[s] = sum % Basis;
+        overflow = 1 - sum / Basis;
+    }
+}
+
+void multiplySchoolbook(const uint32_t *factor1, const size_t size1, const uint32_t *factor2, const size_t size2, uint32_t *product) {
+    std::fill(product, product + size1 + size2, 0);
+
+    for (size_t t = 0; t < size2; ++t) {
+        uint64_t overflow = 0;
+        for (size_t s = 0; s < size1; ++s) {
+            const uint64_t sum = (uint64_t)factor1[s] * factor2[t] + product[s + t] + overflow;
+            product[s + t] = sum % Basis;
+            overflow = sum / Basis;
+        }
+        product[t + size1] = (uint32_t)overflow;
+    }
+}
+
+/*
+Computes the size1 + size2 limbs of factor1 * factor2 with size1 >= size2. For balanced operands
+the factors are split in halves a = a1 B^h + a0, b = b1 B^h + b0 and
+a * b = a1 b1 B^2h + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) B^h + a0 b0.
+Unbalanced operands are cut into pieces of the size of the smaller one. While depth > 0 the
+partial products are computed in parallel by the ThreadPool.
+*/
+void multiplyKaratsuba(const uint32_t *factor1, const size_t size1, const uint32_t *factor2, const size_t size2, uint32_t *product, unsigned depth) {
+    if (size2 < KaratsubaThreshold) {
+        multiplySchoolbook(factor1, size1, factor2, size2, product);
+        return;
+    }
+
+    const size_t half = (size1 + 1) / 2;
+
+    if (size2 <= half) {
+        std::fill(product, product + size1 + size2, 0);
+
+        const size_t pieces = (size1 + size2 - 1) / size2;
+        std::vector<std::vector<uint32_t>> partialProducts(pieces);
+        std::vector<std::function<void()>> tasks;
+
+        for (size_t p = 0; p < pieces; ++p) {
+            const size_t offset = p * size2;
+            const size_t size = std::min(size2, size1 - offset);
+            tasks.push_back([=, &partialProducts]() {
+                partialProducts[p].resize(size + size2);
+                multiplyKaratsuba(factor2, size2, factor1 + offset, size, partialProducts[p].data(), depth > 0 ? depth - 1 : 0);
+            });
+        }
+
+        if (depth > 0) ThreadPool::getInstance().run(tasks);
+        else for (auto &task : tasks) task();
+
+        for (size_t p = 0; p < pieces; ++p) {
+            const size_t offset = p * size2;
+            addLimbs(product + offset, size1 + size2 - offset, partialProducts[p].data(), partialProducts[p].size());
+        }
+        return;
+    }
+
+    const uint32_t *low1 = factor1, *high1 = factor1 + half;
+    const uint32_t *low2 = factor2, *high2 = factor2 + half;
+    const size_t highSize1 = size1 - half, highSize2 = size2 - half;
+
+    std::vector<uint32_t> sum1(half + 1, 0), sum2(half + 1, 0);
+    std::copy(low1, low1 + half, sum1.begin());
+    sum1[half] = addLimbs(sum1.data(), half, high1, highSize1);
+    std::copy(low2, low2 + half, sum2.begin());
+    sum2[half] = addLimbs(sum2.data(), half, high2, highSize2);
+
+    const size_t sumSize = sum1[half] > 0 || sum2[half] > 0 ? half + 1 : half;
+    std::vector<uint32_t> middle(2 * sumSize);
+
+    std::vector<std::function<void()>> tasks;
+    const unsigned next = depth > 0 ? depth - 1 : 0;
+    tasks.push_back([=]() {multiplyKaratsuba(low1, half, low2, half, product, next);});
+    tasks.push_back([=]() {multiplyKaratsuba(high1, highSize1, high2, highSize2, product + 2 * half, next);});
+    tasks.push_back([=, &sum1, &sum2, &middle]() {multiplyKaratsuba(sum1.data(), sumSize, sum2.data(), sumSize, middle.data(), next);});
+
+    if (depth > 0) ThreadPool::getInstance().run(tasks);
+    else for (auto &task : tasks) task();
+
+    subtractLimbs(middle.data(), middle.size(), product, 2 * half);
+    subtractLimbs(middle.data(), middle.size(), product + 2 * half, highSize1 + highSize2);
+
+    size_t middleSize = middle.size();
+    while (middleSize > 0 && middle[middleSize - 1] == 0) --middleSize;
+    addLimbs(product + half, size1 + size2 - half, middle.data(), middleSize);
+}
+
+unsigned parallelDepth(const size_t size) {
+    const unsigned threads = ThreadPool::getInstance().size();
+    if (threads < 2 || size < ParallelThreshold) return 0;
+
+    unsigned depth = 1;
+    for (unsigned tasks = 3; tasks < 2 * threads && (size >> depth) >= ParallelThreshold; tasks *= 3) ++depth;
+    return depth;
+}
+
+/*
+Multiplies the factors in a balanced binary tree, such that the large products have operands of
+similar size. While depth > 0 both halves are computed in parallel by the ThreadPool.
+*/
+template<typename Factor>
+Integer balancedProduct(const Factor *factors, const size_t size, const unsigned depth) {
+    if (size <= 16) {
+        Integer product(1);
+        for (size_t i = 0; i < size; ++i) product *= factors[i];
+        return product;
+    }
+
+    const size_t half = size / 2;
+    Integer low, high;
+
+    std::vector<std::function<void()>> tasks;
+    tasks.push_back([&]() {low = balancedProduct(factors, half, depth > 0 ? depth - 1 : 0);});
+    tasks.push_back([&]() {high = balancedProduct(factors + half, size - half, depth > 0 ? depth - 1 : 0);});
+
+    if (depth > 0) ThreadPool::getInstance().run(tasks);
+    else for (auto &task : tasks) task();
+
+    return low * high;
+}
+
+unsigned productDepth(const size_t size) {
+    const unsigned threads = ThreadPool::getInstance().size();
+    if (threads < 2 || size < 256) return 0;
+
+    unsigned depth = 1;
+    while ((1u << depth) < 2 * threads) ++depth;
+    return depth;
+}
+
+/*
+Multiplies the prime powers p^e, packing as many of them as fit into one word before the
+words are multiplied in a balanced tree.
+*/
+Integer primePowerProduct(const std::vector<uint32_t> &primes, const std::vector<uint32_t> &exponents) {
+    std::vector<uint32_t> words;
+    uint64_t word = 1;
+
+    for (size_t i = 0; i < primes.size(); ++i) {
+        for (uint32_t e = 0; e < exponents[i]; ++e) {
+            if (word * primes[i] > MaxLimit) {
+                words.push_back((uint32_t)word);
+                word = 1;
+            }
+            word *= primes[i];
+        }
+    }
+    if (word > 1) words.push_back((uint32_t)word);
+
+    return Integer::product(words);
+}
+
+uint32_t legendreExponent(uint32_t n, const uint32_t p) {
+    uint32_t exponent = 0;
+    while (n >= p) {
+        n /= p;
+        exponent += n;
+    }
+    return exponent;
+}
+
+/*
+The swinging factorial n!/((n/2)!)^2 contains p with the exponent sum (n/p^k) % 2.
+*/
+Integer primeSwing(const uint32_t n, const std::vector<uint32_t> &primes) {
+    std::vector<uint32_t> exponents(primes.size(), 0);
+
+    for (size_t i = 0; i < primes.size() && primes[i] <= n; ++i) {
+        uint32_t q = n;
+        while (q >= primes[i]) {
+            q /= primes[i];
+            exponents[i] += q % 2;
+        }
+    }
+
+    return primePowerProduct(primes, exponents);
+}
+
+Integer primeSwingFaculty(const uint32_t n, const std::vector<uint32_t> &primes) {
+    if (n < 2) return Integer(1);
+
+    const Integer half = primeSwingFaculty(n / 2, primes);
+    return half * half * primeSwing(n, primes);
+}
+
+ModInteger tonelliShanks(const ModInteger &a, const Integer &p, const Integer &q, uint32_t m) {
+    const ModContext &context = a.getContext();
+    const ModInteger one(context, Integer(1));
+
+    Integer z(2);
+    while (Integer::kroneckerSymbol(z, p) != -1) ++z;
+
+    ModInteger c = ModInteger(context, z).power(q), r = ModInteger(a).power((q + 1) >> 1), t = ModInteger(a).power(q);
+    while (t != one) {
+        uint32_t i = 0;
+        for (ModInteger u = t; u != one; u.square()) ++i;
+
+        ModInteger b = c;
+        for (uint32_t j = 0; j + i + 1 < m; ++j) b.square();
+        m = i;
+        c = b * b;
+        r *= b;
+        t *= c;
+    }
+    return r;
+}
+
+/*
+Cipolla: for a non-residue w = t^2 - a the root is (t + sqrt(w))^((p + 1) / 2) in F_p(sqrt(w)).
+*/
+ModInteger cipolla(const ModInteger &a, const Integer &p) {
+    const ModContext &context = a.getContext();
+    const ModInteger one(context, Integer(1));
+
+    ModInteger t = one, w(context);
+    do {
+        t += one;
+        w = t * t - a;
+    } while (Integer::kroneckerSymbol(w.toInteger(), p) != -1);
+
+    ModInteger x = one, y(context), u = t, v = one;
+    for (Integer e = (p >> 1) + 1; !e.isZero(); e >>= 1) {
+        if (e % 2u == 1) {
+            const ModInteger yv = y * v * w;
+            y = x * v + y * u;
+            x = x * u + yv;
+        }
+        const ModInteger vv = v * v * w;
+        v *= u;
+        v += v;
+        u = u * u + vv;
+    }
+    return x;
+}
+
+// false, if factor() has returned a composite, which resists all its methods, as a factor
+bool factorIntoPrimes(const Integer &n, std::vector<std::pair<Integer, uint32_t>> &factors) {
+    Factorization::factor(n, factors);
+    return std::all_of(factors.begin(), factors.end(), [](const std::pair<Integer, uint32_t> &factor) {return factor.first.millerRabinPrimalityTest();});
+}
+
+uint32_t trailingZeros(const std::vector<uint32_t> &limbs) {
+    uint32_t zeros = 0;
+    while ((limbs[zeros / 32] >> (zeros % 32)) % 2 == 0) ++zeros;
+    return zeros;
+}
+
+/*
+Returns the first probable prime among the odd numbers start, start +- 2, start +- 4, ... . The
+candidates are sieved in windows by the primes of the table, such that only the survivors reach the
+Miller-Rabin-Test. start has to be odd and larger than the sieving primes.
+*/
+Integer searchPrime(Integer start, const bool upwards) {
+    static const std::vector<uint32_t> primes = [] {
+        std::vector<uint32_t> oddPrimes;
+        Primes::getPrimes(std::numeric_limits<uint16_t>::max(), oddPrimes);
+        oddPrimes.erase(oddPrimes.begin());
+        return oddPrimes;
+    }();
+
+    const uint32_t window = std::max<uint32_t>(64, 2 * (uint32_t)start.bitLength());
+    std::vector<uint32_t> rests;
+    std::vector<bool> composite;
+
+    while (true) {
+        start.remainders(primes, rests);
+        composite.assign(window, false);
+
+        for (size_t i = 0; i < primes.size(); ++i) {
+            // start +- 2k is divisible by p for k = -+start / 2 modulo p
+            const uint64_t p = primes[i];
+            const uint64_t rest = upwards ? (p - rests[i]) % p : rests[i];
+            for (uint64_t k = rest * ((p + 1) / 2) % p; k < window; k += p) composite[k] = true;
+        }
+
+        for (uint32_t k = 0; k < window; ++k) {
+            if (composite[k]) continue;
+
+            const Integer candidate = upwards ? start + 2 * k : start - 2 * k;
+            if (candidate.millerRabinPrimalityTest()) return candidate;
+        }
+
+        if (upwards) start += 2 * window;
+        else start -= 2 * window;
+    }
+}
+
+}
+
 Integer::Integer(uint64_t i) :
     positive(true),
     absoluteValue{(uint32_t)(i % Basis), (uint32_t)(i / Basis)}
@@ -128,6 +461,12 @@ void Integer::print(std::string &str) const {
     if (!positive) str = "-" + str;
 }
 
+size_t Integer::bitLength() const {
+    size_t bits = 32 * (absoluteValue.size() - 1);
+    for (uint32_t top = absoluteValue.back(); top > 0; top >>= 1) ++bits;
+    return bits;
+}
+
 bool Integer::isSigned64Bit() const {
     if (absoluteValue.size() > 2) return false;
     if (absoluteValue.size() == 1) return true;
@@ -144,7 +483,8 @@ bool Integer::operator >(const Integer &rhs) const {
     if (!positive && rhs.positive) return false;
     else if (positive && !rhs.positive && (!rhs.isZero() || !isZero())) return true;
 
-    return positive == isAbsoluteValueLarger(absoluteValue, rhs.absoluteValue);
+    return positive ? isAbsoluteValueLarger(absoluteValue, rhs.absoluteValue)
+                    : isAbsoluteValueLarger(rhs.absoluteValue, absoluteValue);
 }
 
 bool Integer::operator ==(const Integer &rhs) const {
@@ -193,15 +533,7 @@ Integer Integer::operator /(const Integer &divisor) const {
 }
 
 Integer Integer::operator %(const Integer &rhs) const {
-    Integer quotient;
-    quotient.positive = rhs.positive == positive;
-    divide(absoluteValue, rhs.absoluteValue, quotient.absoluteValue);
-    if (positive) return *this - rhs * quotient;
-    else {
-        Integer z = rhs * quotient;
-        addAbsValues(z.absoluteValue, rhs.absoluteValue, z.absoluteValue);
-        return *this - z;
-    }
+    return divideWithRest(rhs).second;
 }
 
 std::pair<Integer, Integer> Integer::divideWithRest(const Integer &rhs) const {
@@ -209,16 +541,13 @@ std::pair<Integer, Integer> Integer::divideWithRest(const Integer &rhs) const {
     quotient.positive = positive == rhs.positive;
     divide(absoluteValue, rhs.absoluteValue, quotient.absoluteValue);
 
-    if (positive) return std::make_pair(quotient, *this - rhs * quotient);
-
-    Integer z = rhs * quotient;
+    Integer rest;
+    multiplyAbsoluteValues(quotient.absoluteValue, rhs.absoluteValue, rest.absoluteValue);
+    subtractAbsValues(absoluteValue, rest.absoluteValue, rest.absoluteValue);
 
-    std::vector<uint32_t> sum;
-    addAbsValues(z.absoluteValue, rhs.absoluteValue, sum);
-    subtractAbsValues(sum, absoluteValue, z.absoluteValue);
-    z.positive = true;
+    if (!positive && !rest.isZero()) subtractAbsValues(rhs.absoluteValue, rest.absoluteValue, rest.absoluteValue);
 
-    return std::make_pair(quotient, z);
+    return std::make_pair(quotient, rest);
 }
 
 Integer Integer::operator +(const uint32_t i) const {
@@ -306,6 +635,74 @@ std::pair<Integer, uint32_t> Integer::divideWithRest(const uint32_t i) const{
     return std::make_pair(result, overflow);
 }
 
+void Integer::remainders(const std::vector<uint32_t> &moduli, std::vector<uint32_t> &result) const {
+    const size_t count = moduli.size();
+    const size_t size = absoluteValue.size();
+    result.resize(count);
+
+    size_t m = 0;
+    for (; m + RemainderLanes <= count; m += RemainderLanes) {
+        uint64_t rests[RemainderLanes] = {};
+        for (size_t s = size; s > 0; --s) {
+            const uint64_t limb = absoluteValue[s - 1];
+            for (size_t lane = 0; lane < RemainderLanes; ++lane) {
+                rests[lane] = ((rests[lane] << 32) + limb) % moduli[m + lane];
+            }
+        }
+        for (size_t lane = 0; lane < RemainderLanes; ++lane) result[m + lane] = (uint32_t)rests[lane];
+    }
+
+    for (; m < count; ++m) {
+        uint64_t rest = 0;
+        for (size_t s = size; s > 0; --s) rest = ((rest << 32) + absoluteValue[s - 1]) % moduli[m];
+        result[m] = (uint32_t)rest;
+    }
+
+    if (!positive) {
+        for (size_t s = 0; s < count; ++s) {
+            if (result[s] != 0) result[s] = moduli[s] - result[s];
+        }
+    }
+}
+
+Integer Integer::operator <<(const uint32_t bits) const {
+    if (isZero()) return *this;
+
+    const size_t limbs = bits / 32, shift = bits % 32;
+    const size_t size = absoluteValue.size();
+
+    Integer result;
+    result.positive = positive;
+    result.absoluteValue.assign(size + limbs + 1, 0);
+
+    for (size_t s = 0; s < size; ++s) {
+        const uint64_t shifted = (uint64_t)absoluteValue[s] << shift;
+        result.absoluteValue[s + limbs] |= shifted % Basis;
+        result.absoluteValue[s + limbs + 1] = shifted / Basis;
+    }
+
+    while (result.absoluteValue.back() == 0 && result.absoluteValue.size() > 1) result.absoluteValue.pop_back();
+    return result;
+}
+
+Integer Integer::operator >>(const uint32_t bits) const {
+    const size_t limbs = bits / 32, shift = bits % 32;
+    const size_t size = absoluteValue.size();
+
+    Integer result;
+    result.positive = positive;
+    if (limbs >= size) return result;
+
+    result.absoluteValue.resize(size - limbs);
+    for (size_t s = limbs; s < size; ++s) {
+        const uint64_t upper = s + 1 < size ? (uint64_t)absoluteValue[s + 1] << 32 : 0;
+        result.absoluteValue[s - limbs] = (uint32_t)((upper + absoluteValue[s]) >> shift);
+    }
+
+    while (result.absoluteValue.back() == 0 && result.absoluteValue.size() > 1) result.absoluteValue.pop_back();
+    return result;
+}
+
 Integer &Integer::operator +=(const Integer &rhs) {
     *this = *this + rhs;
     return *this;
@@ -356,6 +753,16 @@ Integer &Integer::operator %=(const uint32_t i) {
     return *this;
 }
 
+Integer &Integer::operator <<=(const uint32_t bits) {
+    *this = *this << bits;
+    return *this;
+}
+
+Integer &Integer::operator >>=(const uint32_t bits) {
+    *this = *this >> bits;
+    return *this;
+}
+
 Integer &Integer::operator --() {
     *this = *this - 1;
     return *this;
@@ -391,6 +798,93 @@ Integer &Integer::power(Integer exponent) {
     return *this;
 }
 
+Integer &Integer::isqrt() {
+    return iroot(2);
+}
+
+/*
+Replaces the value by its n-th root truncated toward zero, i.e. the floor for positive values and
+the ceiling for negative values with odd n. Even roots of negative values and n < 2 change nothing.
+*/
+Integer &Integer::iroot(const uint32_t n) {
+    if (n < 2 || (!isPositive() && n % 2 == 0) || (absoluteValue.size() == 1 && absoluteValue[0] < 2)) return *this;
+
+    const bool sign = isPositive();
+    positive = true;
+
+    const size_t bits = bitLength();
+    if (bits <= n) {
+        set(1);
+        positive = sign;
+        return *this;
+    }
+
+    Integer x;
+    if (n <= 52) {
+        const uint32_t shift = bits > 104 ? (uint32_t)((bits - 104) / n * n) : 0;
+        const double top = (*this >> shift).toDouble();
+        const double root = n == 2 ? std::sqrt(top) : std::pow(top, 1.0 / n);
+        x = Integer((uint64_t)root + 2) << (shift / n);
+    }
+    else {
+        x = Integer(1) << (uint32_t)((bits + n - 1) / n);
+    }
+
+    while (true) {
+        Integer y = x;
+        y.power(Integer(n - 1));
+        y = (x * (n - 1) + *this / y) / n;
+        if (!(y < x)) break;
+        x = y;
+    }
+
+    *this = x;
+    positive = sign;
+    return *this;
+}
+
+bool Integer::isPerfectSquare() const {
+    static const std::vector<bool> squares64 = [] {
+        std::vector<bool> squares(64, false);
+        for (uint32_t i = 0; i < 64; ++i) squares[i * i % 64] = true;
+        return squares;
+    }();
+    static const std::vector<bool> squares45045 = [] {
+        std::vector<bool> squares(45045, false);
+        for (uint32_t i = 0; i < 45045; ++i) squares[i * i % 45045] = true;
+        return squares;
+    }();
+
+    if (!isPositive()) return false;
+    if (!squares64[absoluteValue[0] % 64]) return false;
+
+    if (!squares45045[*this % 45045]) return false;
+
+    Integer root = *this;
+    root.isqrt();
+    return root * root == *this;
+}
+
+bool Integer::isPerfectPower() const {
+    if (absoluteValue.size() == 1 && absoluteValue[0] < 2) return true;
+    if (isPerfectSquare()) return true;
+
+    Integer absolute = *this;
+    absolute.positive = true;
+
+    const size_t bits = bitLength();
+    for (uint32_t n = 3; n <= bits; n += 2) {
+        if (!Primes::getInstance().isPrime(n)) continue;
+
+        Integer root = absolute;
+        root.iroot(n);
+        Integer power = root;
+        if (power.power(Integer(n)) == absolute) return true;
+    }
+
+    return false;
+}
+
 Integer &Integer::invertModulo(Integer n) {
     positive = true;
     n.positive = true;
@@ -426,21 +920,52 @@ Integer &Integer::invertModulo(Integer n) {
 
 Integer &Integer::powerModulo(Integer exponent, const Integer &mod) {
     if (exponent.isPositive()) {
-        Integer base = *this % mod;
-        *this = Integer(1);
-        while (!exponent.isZero()) {
-            if ((exponent % 2) == 1) {
-                *this *= base;
-                *this %= mod;
-            }
-            exponent /= 2;
-            base *= base;
-            base %= mod;
+        if (exponent.isZero()) set(1);
+        else {
+            ModContext context(mod);
+            *this = ModInteger(context, *this).power(exponent).toInteger();
         }
     }
     return *this;
 }
 
+/*
+Replaces a quadratic residue by its smaller square root modulo the prime p and other values by p,
+as well as every value, if p fails the Miller-Rabin-Test.
+*/
+Integer &Integer::sqrtModulo(Integer p) {
+    p.abs();
+    if (p.isUnsigned32Bit()) {
+        const uint32_t prime = p.absoluteValue[0];
+        set(prime < 2 ? prime : Primes::sqrtModulo(*this % prime, prime));
+        return *this;
+    }
+    if (!p.millerRabinPrimalityTest()) {
+        *this = p;
+        return *this;
+    }
+
+    const ModContext context(p);
+    const ModInteger a(context, *this);
+    if (a.isZero()) {
+        set(0);
+        return *this;
+    }
+    if (kroneckerSymbol(a.toInteger(), p) != 1) {
+        *this = p;
+        return *this;
+    }
+
+    Integer q = p - 1;
+    uint32_t s = 0;
+    for (; q.absoluteValue[0] % 2 == 0; ++s) q >>= 1;
+
+    const uint64_t bits = p.bitLength();
+    *this = ((uint64_t)s * (s - 1) > 8 * bits + 20 ? cipolla(a, p) : tonelliShanks(a, p, q, s)).toInteger();
+    if (*this > p - *this) *this = p - *this;
+    return *this;
+}
+
 Integer &Integer::abs() {
     positive = true;
     return *this;
@@ -451,93 +976,222 @@ Integer &Integer::minusAbs() {
     return *this;
 }
 
-bool Integer::millerRabinPrimalityTest() {
+bool Integer::millerRabinPrimalityTest() const {
     if (absoluteValue.size() == 1) return Primes::getInstance().isPrime(absoluteValue[0]);
+    if (absoluteValue[0] % 2 == 0) return false;
 
-    if (*this % 2 == 0) return false;
+    static const std::vector<uint32_t> smallPrimes = {3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97};
+    for (const uint32_t p : smallPrimes) {
+        if (*this % p == 0) return false;
+    }
 
-    Integer a = *this / 2;
-    Integer d = *this - 1;
-    uint64_t powerOfTwo = 0;
+    Integer n = *this;
+    n.abs();
 
-    while (d % 2 == 0) {
-        d /= 2;
+    Integer d = n - 1;
+    uint32_t powerOfTwo = 0;
+    while (d.absoluteValue[0] % 2 == 0) {
+        d >>= 1;
         ++powerOfTwo;
     }
 
-    Integer power = a;
-    power.powerModulo(d, *this);
+    // The first 13 primes as bases are deterministic below 3.3 * 10^24, larger n get random bases in addition.
+    std::vector<Integer> bases;
+    for (const uint32_t p : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41}) bases.push_back(Integer(p));
+    if (n.bitLength() > 81) {
+        RandomGenerator generator(n.absoluteValue[0]);
+        for (uint32_t i = 0; i < 12; ++i) bases.push_back(generator.below(n - 3) + 2);
+    }
+
+    const ModContext context(n);
+    const ModInteger one(context, Integer(1)), minusOne(context, n - 1);
 
-    if (power == Integer(1) || power == *this - 1) return true;
+    for (const Integer &base : bases) {
+        ModInteger x(context, base);
+        x.power(d);
+        if (x == one || x == minusOne) continue;
 
-    for (uint64_t j = 1; j < powerOfTwo; ++j) {
-        a *= a;
-        if (power * a == *this - 1) return true;
+        uint32_t j = 1;
+        for (; j < powerOfTwo; ++j) {
+            x.square();
+            if (x == minusOne || x == one) break;
+        }
+        if (j == powerOfTwo || x == one) return false;
     }
 
-    return false;
+    return true;
 }
 
-Integer Integer::fibonacci(const uint32_t i) {
-    if (i < 2) return Integer(i);
+/*
+Decides whether the Mersenne number 2^p - 1 is prime. The squarings modulo 2^p - 1 are reduced by
+the special form reduction of ModContext.
+*/
+bool Integer::lucasLehmerTest(const uint32_t p) {
+    if (p == 2) return true;
+    if (!Primes::getInstance().isPrime(p)) return false;
 
-    Integer result;
-    std::vector<uint32_t> f, g{1}, h{0};
+    const ModContext context((Integer(1) << p) - 1);
+    const ModInteger two(context, Integer(2));
+    ModInteger s(context, Integer(4));
 
-    for (uint32_t j = 2; j <= i; ++j) {
-        result.addAbsValues(g, h, f);
-        h = g;
-        g = f;
+    for (uint32_t i = 2; i < p; ++i) {
+        s.square();
+        s -= two;
     }
 
-    result.absoluteValue = f;
+    return s.isZero();
+}
 
-    return result;
+Integer &Integer::nextPrime() {
+    if (!isPositive() || (absoluteValue.size() == 1 && absoluteValue[0] < 2)) {
+        set(2);
+        return *this;
+    }
+
+    if (absoluteValue.size() == 1) {
+        for (uint64_t i = absoluteValue[0] + 1 + absoluteValue[0] % 2; i < Basis; i += 2) {
+            if (Primes::getInstance().isPrime((uint32_t)i)) {
+                set((uint32_t)i);
+                return *this;
+            }
+        }
+    }
+
+    Integer start = *this + 1;
+    if (start.absoluteValue[0] % 2 == 0) ++start;
+    *this = searchPrime(start, true);
+    return *this;
+}
+
+Integer &Integer::prevPrime() {
+    if (!isPositive() || (absoluteValue.size() == 1 && absoluteValue[0] <= 2)) return *this;
+
+    if (absoluteValue.size() == 1) {
+        if (absoluteValue[0] == 3) {
+            set(2);
+            return *this;
+        }
+
+        uint32_t i = absoluteValue[0] - 1 - absoluteValue[0] % 2;
+        while (!Primes::getInstance().isPrime(i)) i -= 2;
+        set(i);
+        return *this;
+    }
+
+    Integer start = *this - 1;
+    if (start.absoluteValue[0] % 2 == 0) --start;
+    *this = searchPrime(start, false);
+    return *this;
+}
+
+Integer Integer::fibonacci(const uint32_t i) {
+    if (i < 2) return Integer(i);
+
+    const std::pair<Integer, Integer> half = fibonacciPair(i / 2);
+    if (i % 2 == 1) return half.first * half.first + half.second * half.second;
+    return half.first * (half.second * 2 - half.first);
 }
 
 Integer Integer::lucas(const uint32_t i) {
-    if (i == 0) return Integer(2);
-    if (i == 1) return Integer(1);
+    return lucasPair(i).first;
+}
 
-    Integer result;
-    std::vector<uint32_t> f, g{1}, h{2};
+std::pair<Integer, Integer> Integer::fibonacciPair(const uint32_t i) {
+    Integer f(0), g(1);
+
+    uint32_t bit = 1u << 31;
+    while (bit > i) bit >>= 1;
 
-    for (uint32_t j = 2; j <= i; ++j) {
-        result.addAbsValues(g, h, f);
-        h = g;
-        g = f;
+    for (; bit > 0; bit >>= 1) {
+        Integer even = f * (g * 2 - f);
+        Integer odd = f * f + g * g;
+
+        if (i & bit) {
+            f = odd;
+            g = even + odd;
+        }
+        else {
+            f = even;
+            g = odd;
+        }
     }
 
-    result.absoluteValue = f;
+    return std::make_pair(f, g);
+}
 
-    return result;
+std::pair<Integer, Integer> Integer::lucasPair(const uint32_t i) {
+    const std::pair<Integer, Integer> fibonacci = fibonacciPair(i);
+    return std::make_pair(fibonacci.second * 2 - fibonacci.first, fibonacci.first);
+}
+
+Integer Integer::product(const std::vector<Integer> &factors) {
+    return balancedProduct(factors.data(), factors.size(), productDepth(factors.size()));
+}
+
+Integer Integer::product(const std::vector<uint32_t> &factors) {
+    return balancedProduct(factors.data(), factors.size(), productDepth(factors.size()));
 }
 
 Integer Integer::faculty(const uint32_t i) {
-    Integer f(i), g(1);
+    if (i == 0) return Integer(0);
 
-    for (uint32_t j = 2; j < i; ++j) {
-        f *= j;
-    }
+    std::vector<uint32_t> primes;
+    Primes::getPrimes(i, primes);
+    return primeSwingFaculty(i, primes);
+}
+
+Integer Integer::doubleFaculty(const uint32_t i) {
+    if (i < 2) return Integer(1);
+
+    const uint32_t half = i / 2;
+    if (i % 2 == 0) return faculty(half) << half;
+
+    // (2k+1)!! = (2k+1)! / (2^k k!)
+    std::vector<uint32_t> primes, exponents;
+    Primes::getPrimes(i, primes);
+    primes.erase(primes.begin());
+    for (const uint32_t p : primes) exponents.push_back(legendreExponent(i, p) - legendreExponent(half, p));
+
+    return primePowerProduct(primes, exponents);
+}
 
-    return f * g;
+Integer Integer::primorial(const uint32_t i) {
+    std::vector<uint32_t> primes;
+    Primes::getPrimes(i, primes);
+    return primePowerProduct(primes, std::vector<uint32_t>(primes.size(), 1));
 }
 
 Integer Integer::binomial(uint32_t a, uint32_t b) {
-    if (b > a / 2) b = a - b;
+    if (b > a) return Integer(0);
 
-    if (a < b) return Integer(0);
+    b = std::min(b, a - b);
+    if (b == 0) return Integer(1);
 
-    if (a == b || b == 0) return Integer(1);
+    std::vector<uint32_t> primes, exponents;
 
-    Integer f(a), g = faculty(b);
+    // For small b factor the b numerator and denominator terms instead of sieving up to a.
+    if ((uint64_t)b * 64 < a) {
+        std::vector<uint32_t> numerator, denominator, factors;
+        for (uint32_t i = 0; i < b; ++i) {
+            Primes::getPrimeFactorsWithMultiplicity(a - i, factors);
+            numerator.insert(numerator.end(), factors.begin(), factors.end());
+            Primes::getPrimeFactorsWithMultiplicity(i + 1, factors);
+            denominator.insert(denominator.end(), factors.begin(), factors.end());
+        }
+        std::sort(numerator.begin(), numerator.end());
+        std::sort(denominator.begin(), denominator.end());
+        std::set_difference(numerator.begin(), numerator.end(), denominator.begin(), denominator.end(), std::back_inserter(primes));
 
-    for (uint32_t i = 0; i < b - 1; ++i) {
-        --a;
-        f *= a;
+        return primePowerProduct(primes, std::vector<uint32_t>(primes.size(), 1));
     }
 
-    return f/g;
+    // Legendre: the exponent of p in a!/(b!(a-b)!)
+    Primes::getPrimes(a, primes);
+    for (const uint32_t p : primes) {
+        exponents.push_back(legendreExponent(a, p) - legendreExponent(b, p) - legendreExponent(a - b, p));
+    }
+
+    return primePowerProduct(primes, exponents);
 }
 
 Integer Integer::multiSet(const uint32_t a, const uint32_t b) {
@@ -606,6 +1260,165 @@ Integer Integer::lcm(const Integer &a, const Integer &b) {
     else return a * b / gcd(a, b);
 }
 
+/*
+gcds[s] = gcd(values[s], product of all other values) by the remainder tree of the product tree.
+A zero value makes the product of the others zero, such that gcds[s] = |values[s]| for the other
+values, while the zero itself gets the absolute product of the others, or zero if they contain a
+second zero.
+*/
+void Integer::batchGcd(const std::vector<Integer> &values, std::vector<Integer> &gcds) {
+    std::vector<Integer> nonZero;
+    for (const Integer &value : values) {
+        if (!value.isZero()) nonZero.push_back(value);
+    }
+
+    if (nonZero.size() < values.size()) {
+        Integer rest = nonZero.size() + 1 == values.size() ? product(nonZero) : Integer(0);
+        rest.abs();
+
+        gcds.resize(values.size());
+        for (size_t s = 0; s < values.size(); ++s) {
+            gcds[s] = values[s].isZero() ? rest : values[s];
+            gcds[s].abs();
+        }
+        return;
+    }
+
+    ProductTree tree(values);
+
+    std::vector<Integer> rests{tree.root()};
+    for (size_t l = tree.height() - 1; l > 0; --l) {
+        const std::vector<Integer> &nodes = tree.level(l - 1);
+
+        std::vector<Integer> lower(nodes.size());
+        std::vector<std::function<void()>> tasks;
+        for (size_t s = 0; s < nodes.size(); ++s) {
+            tasks.push_back([&lower, &nodes, &rests, s]() {lower[s] = rests[s / 2] % (nodes[s] * nodes[s]);});
+        }
+        ThreadPool::getInstance().run(tasks);
+
+        rests.swap(lower);
+    }
+
+    gcds.resize(values.size());
+    std::vector<std::function<void()>> tasks;
+    for (size_t s = 0; s < values.size(); ++s) {
+        tasks.push_back([&gcds, &values, &rests, s]() {gcds[s] = gcd(rests[s] / values[s], values[s]);});
+    }
+    ThreadPool::getInstance().run(tasks);
+}
+
+/*
+The product of the bases[i]^exponents[i] modulo mod, over the indices present in both vectors.
+*/
+Integer Integer::multiPowerModulo(const std::vector<Integer> &bases, const std::vector<Integer> &exponents, const Integer &mod) {
+    const ModContext context(mod);
+
+    std::vector<ModInteger> residues;
+    for (const Integer &base : bases) residues.push_back(ModInteger(context, base));
+    return ModInteger::multiPower(context, residues, exponents).toInteger();
+}
+
+/*
+Returns the multiplicative order of a modulo n or 0, if a is no unit. phi(n) and its prime factors
+are taken from the factorization of n and of the q - 1 for its prime factors q. If Factorization
+cannot split one of these numbers completely, the order is unknown and 0 is returned as well.
+*/
+Integer Integer::order(const Integer &a, const Integer &n) {
+    Integer modulus = n;
+    modulus.abs();
+    if (modulus.isUnsigned32Bit()) {
+        const uint32_t m = modulus.absoluteValue[0];
+        return Integer(m < 2 ? m : Primes::order(ModContext(modulus).reduce(a).absoluteValue[0], m));
+    }
+    if (gcd(a, modulus) != Integer(1)) return Integer(0);
+
+    std::vector<std::pair<Integer, uint32_t>> factors, phiFactors;
+    if (!factorIntoPrimes(modulus, factors)) return Integer(0);
+
+    Integer result(1);
+    std::vector<Integer> primes;
+    for (const auto &factor : factors) {
+        result *= factor.first - 1;
+        for (uint32_t e = 1; e < factor.second; ++e) result *= factor.first;
+        if (factor.second > 1) primes.push_back(factor.first);
+
+        if (!factorIntoPrimes(factor.first - 1, phiFactors)) return Integer(0);
+        for (const auto &phiFactor : phiFactors) primes.push_back(phiFactor.first);
+    }
+    std::sort(primes.begin(), primes.end());
+    primes.erase(std::unique(primes.begin(), primes.end()), primes.end());
+
+    const ModContext context(modulus);
+    const ModInteger base(context, a), one(context, Integer(1));
+    for (const Integer &q : primes) {
+        while ((result % q).isZero() && ModInteger(base).power(result / q) == one) result /= q;
+    }
+
+    return result;
+}
+
+/*
+Returns the smallest primitive root modulo the prime p or 0, if p fails the Miller-Rabin-Test or
+Factorization cannot split p - 1 into primes.
+*/
+Integer Integer::primitiveRoot(const Integer &p) {
+    Integer prime = p;
+    prime.abs();
+    if (prime.isUnsigned32Bit()) return Integer(Primes::primitiveRoot(prime.absoluteValue[0]));
+    if (!prime.millerRabinPrimalityTest()) return Integer(0);
+
+    std::vector<std::pair<Integer, uint32_t>> factors;
+    if (!factorIntoPrimes(prime - 1, factors)) return Integer(0);
+
+    std::vector<Integer> exponents;
+    for (const auto &factor : factors) exponents.push_back((prime - 1) / factor.first);
+
+    const ModContext context(prime);
+    const ModInteger one(context, Integer(1));
+    for (Integer g(2); ; ++g) {
+        const ModInteger base(context, g);
+        if (std::none_of(exponents.begin(), exponents.end(), [&base, &one](const Integer &e) {return ModInteger(base).power(e) == one;})) return g;
+    }
+}
+
+/*
+Binary Kronecker symbol: factors 2 are removed by (2 / n), odd a < n are swapped with n by
+quadratic reciprocity and a - n replaces a, such that only subtractions and shifts are needed.
+*/
+int32_t Integer::kroneckerSymbol(Integer a, Integer b) {
+    if (b.isZero()) return a.absoluteValue.size() == 1 && a.absoluteValue[0] == 1 ? 1 : 0;
+    if (a.absoluteValue[0] % 2 == 0 && b.absoluteValue[0] % 2 == 0) return 0;
+
+    int32_t result = 1;
+    if (!b.isPositive()) {
+        b.positive = true;
+        if (!a.isPositive()) result = -result;
+    }
+
+    // (a / 2) = 1 for a = 1, 7 mod 8 and -1 for a = 3, 5 mod 8
+    const uint32_t zeros = trailingZeros(b.absoluteValue);
+    b >>= zeros;
+    if (zeros % 2 == 1 && (a % 8u == 3 || a % 8u == 5)) result = -result;
+
+    a %= b;
+    if (!a.isPositive()) a += b;
+
+    while (!a.isZero()) {
+        const uint32_t shift = trailingZeros(a.absoluteValue);
+        a >>= shift;
+        if (shift % 2 == 1 && (b.absoluteValue[0] % 8 == 3 || b.absoluteValue[0] % 8 == 5)) result = -result;
+
+        if (a < b) {
+            std::swap(a, b);
+            if (a.absoluteValue[0] % 4 == 3 && b.absoluteValue[0] % 4 == 3) result = -result;
+        }
+        a -= b;
+    }
+
+    return b.absoluteValue.size() == 1 && b.absoluteValue[0] == 1 ? result : 0;
+}
+
 void Integer::performAddition(bool positiveSignum, const Integer &rhs, Integer &result) const {
     if (positiveSignum) {
         result.positive = positive;
@@ -853,39 +1666,20 @@ void Integer::addFromIndex(std::vector<uint32_t> &value, uint32_t i, const size_
 
 void Integer::multiplyAbsoluteValues(const std::vector<uint32_t> &factor1, const std::vector<uint32_t> &factor2, std::vector<uint32_t> &product) const
 {
-    size_t size1 = factor1.size(), size2 = factor2.size();
-
-    uint64_t overflow = 0;
-    uint64_t sum = 0;
-    size_t u = 0, resultSize = size1 + size2 - 1;
-    bool resized = false;
+    const std::vector<uint32_t> &larger = factor1.size() >= factor2.size() ? factor1 : factor2;
+    const std::vector<uint32_t> &smaller = factor1.size() >= factor2.size() ? factor2 : factor1;
+
+    if (&product == &factor1 || &product == &factor2) {
+        std::vector<uint32_t> result;
+        multiplyAbsoluteValues(factor1, factor2, result);
+        product.swap(result);
+        return;
+    }
 
-    product.resize(resultSize, 0);
+    product.resize(larger.size() + smaller.size());
+    multiplyKaratsuba(larger.data(), larger.size(), smaller.data(), smaller.size(), product.data(), parallelDepth(smaller.size()));
 
-    for (size_t s = 0; s < size1; ++s) {
-        for (size_t t = 0; t < size2; ++t) {
-            sum = (uint64_t)factor1[s] * factor2[t] + product[s+t];
-            product[s+t] = sum % Basis;
-            overflow = sum / Basis;
-            u = s+t;
-            while (overflow > 0) {
-                u++;
-                if (u >= resultSize) {
-                    if (resized) product[u] += (uint32_t)overflow;
-                    else {
-                        product.push_back((uint32_t)overflow);
-                        resized = true;
-                    }
-                    overflow = 0;
-                }
-                else {
-                    sum = overflow + product[u];
-                    product[u] = sum % Basis;
-                    overflow = sum / Basis;
-                }
-            }
-        }
-    }
+    while (product.back() == 0 && product.size() > 1) product.pop_back();
 }
 
 void Integer::multiplyVectorByUnsignedInt(const std::vector<uint32_t> &vec, const uint32_t i, std::vector<uint32_t> &result, uint32_t &overflow) const {
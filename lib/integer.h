@@ -21,6 +21,7 @@ along with ampclib; if not, see http://www.gnu.org/licenses.
 #include <stdlib.h>
 #include <string>
 #include <algorithm>
+#include <limits>
 
 namespace ampc {
 
@@ -53,6 +54,8 @@ public:
 
     void print(std::string &str) const;
 
+    size_t bitLength() const;
+
     bool isZero() const {return absoluteValue.size() == 1 && absoluteValue[0] == 0;}
     bool isPositive() const {return positive || isZero();}
     bool isUnsigned16Bit() const {return isUnsigned32Bit() && absoluteValue[0] <= std::numeric_limits<uint16_t>::max();}
@@ -62,7 +65,7 @@ public:
 
     bool operator >(const Integer &rhs) const;
     bool operator >=(const Integer &rhs) const {return !(rhs > *this);}
-    bool operator <(const Integer &rhs) const {return rhs >= *this;}
+    bool operator <(const Integer &rhs) const {return rhs > *this;}
     bool operator <=(const Integer &rhs) const {return !(*this > rhs);}
     bool operator ==(const Integer &rhs) const;
     bool operator !=(const Integer &rhs) const {return !(*this == rhs);}
@@ -84,6 +87,11 @@ public:
 
     std::pair<Integer, uint32_t> divideWithRest(const uint32_t i) const;
 
+    void remainders(const std::vector<uint32_t> &moduli, std::vector<uint32_t> &result) const;
+
+    Integer operator <<(const uint32_t bits) const;
+    Integer operator >>(const uint32_t bits) const;
+
     Integer &operator +=(const Integer &rhs);
     Integer &operator -=(const Integer &rhs);
     Integer &operator *=(const Integer &rhs);
@@ -96,31 +104,59 @@ public:
     Integer &operator /=(const uint32_t i);
     Integer &operator %=(const uint32_t i);
 
+    Integer &operator <<=(const uint32_t bits);
+    Integer &operator >>=(const uint32_t bits);
+
     Integer &operator --();
     Integer &operator ++();
     Integer operator --(int);
     Integer operator ++(int);
 
     Integer &power(Integer exponent);
+    Integer &isqrt();
+    Integer &iroot(const uint32_t n);
+
+    bool isPerfectSquare() const;
+    bool isPerfectPower() const;
 
     Integer &invertModulo(Integer n);
     Integer &powerModulo(Integer exponent, const Integer &mod);
+    Integer &sqrtModulo(Integer p);
 
     Integer &abs();
     Integer &minusAbs();
 
-    bool millerRabinPrimalityTest();
+    bool millerRabinPrimalityTest() const;
+    static bool lucasLehmerTest(const uint32_t p);
+    Integer &nextPrime();
+    Integer &prevPrime();
 
     static Integer fibonacci(const uint32_t i);
     static Integer lucas(const uint32_t i);
+    static std::pair<Integer, Integer> fibonacciPair(const uint32_t i);
+    static std::pair<Integer, Integer> lucasPair(const uint32_t i);
+    static Integer product(const std::vector<Integer> &factors);
+    static Integer product(const std::vector<uint32_t> &factors);
     static Integer faculty(const uint32_t i);
+    static Integer doubleFaculty(const uint32_t i);
+    static Integer primorial(const uint32_t i);
     static Integer binomial(uint32_t a, const uint32_t b);
     static Integer multiSet(const uint32_t a, const uint32_t b);
     static Integer gcd(Integer a, Integer b);
     static Integer extendedEuclidianAlgo(Integer a, Integer b, Integer &r, Integer &s);
     static Integer lcm(const Integer &a, const Integer &b);
+    static void batchGcd(const std::vector<Integer> &values, std::vector<Integer> &gcds);
+    static Integer multiPowerModulo(const std::vector<Integer> &bases, const std::vector<Integer> &exponents, const Integer &mod);
+    static Integer order(const Integer &a, const Integer &n);
+    static Integer primitiveRoot(const Integer &p);
+    static int32_t kroneckerSymbol(Integer a, Integer b);
 
 private:
+    friend class IntegerVector;
+    friend class ModContext;
+    friend class ModInteger;
+    friend class RandomGenerator;
+
     bool positive;
     std::vector<uint32_t> absoluteValue;
 
@@ -0,0 +1,269 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <integervector.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace ampc {
+
+#if defined(__AVX2__)
+constexpr size_t Lanes = 8;
+#elif defined(__ARM_NEON)
+constexpr size_t Lanes = 4;
+#else
+constexpr size_t Lanes = 1;
+#endif
+
+void IntegerVector::set(const size_t index, const Integer &value) {
+    const size_t size = std::min(limbs, value.absoluteValue.size());
+
+    for (size_t s = 0; s < size; ++s) data[s * elements + index] = value.absoluteValue[s];
+    for (size_t s = size; s < limbs; ++s) data[s * elements + index] = 0;
+}
+
+Integer IntegerVector::get(const size_t index) const {
+    Integer result;
+    result.absoluteValue.resize(limbs > 0 ? limbs : 1, 0);
+
+    for (size_t s = 0; s < limbs; ++s) result.absoluteValue[s] = data[s * elements + index];
+
+    while (result.absoluteValue.back() == 0 && result.absoluteValue.size() > 1) result.absoluteValue.pop_back();
+    return result;
+}
+
+void IntegerVector::add(const IntegerVector &rhs, std::vector<uint32_t> &carries) {
+    carries.resize(elements);
+    size_t begin = 0;
+
+#if defined(__AVX2__)
+    for (; begin + Lanes <= elements; begin += Lanes) {
+        __m256i carry = _mm256_setzero_si256();
+        for (size_t s = 0; s < limbs; ++s) {
+            __m256i *lhs = (__m256i *)&data[s * elements + begin];
+            const __m256i a = _mm256_loadu_si256(lhs);
+            const __m256i b = _mm256_loadu_si256((const __m256i *)&rhs.data[s * elements + begin]);
+
+            const __m256i sum = _mm256_add_epi32(a, b);
+            const __m256i total = _mm256_add_epi32(sum, carry);
+            const __m256i sumOverflow = _mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_max_epu32(sum, a), sum), _mm256_set1_epi32(-1));
+            const __m256i totalOverflow = _mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_max_epu32(total, sum), total), _mm256_set1_epi32(-1));
+
+            carry = _mm256_srli_epi32(_mm256_or_si256(sumOverflow, totalOverflow), 31);
+            _mm256_storeu_si256(lhs, total);
+        }
+        _mm256_storeu_si256((__m256i *)&carries[begin], carry);
+    }
+#elif defined(__ARM_NEON)
+    for (; begin + Lanes <= elements; begin += Lanes) {
+        uint32x4_t carry = vdupq_n_u32(0);
+        for (size_t s = 0; s < limbs; ++s) {
+            uint32_t *lhs = &data[s * elements + begin];
+            const uint32x4_t a = vld1q_u32(lhs);
+            const uint32x4_t b = vld1q_u32(&rhs.data[s * elements + begin]);
+
+            const uint32x4_t sum = vaddq_u32(a, b);
+            const uint32x4_t total = vaddq_u32(sum, carry);
+
+            carry = vshrq_n_u32(vorrq_u32(vcltq_u32(sum, a), vcltq_u32(total, sum)), 31);
+            vst1q_u32(lhs, total);
+        }
+        vst1q_u32(&carries[begin], carry);
+    }
+#endif
+
+    addScalar(rhs, carries.data(), begin);
+}
+
+void IntegerVector::subtract(const IntegerVector &rhs, std::vector<uint32_t> &borrows) {
+    borrows.resize(elements);
+    size_t begin = 0;
+
+#if defined(__AVX2__)
+    for (; begin + Lanes <= elements; begin += Lanes) {
+        __m256i borrow = _mm256_setzero_si256();
+        for (size_t s = 0; s < limbs; ++s) {
+            __m256i *lhs = (__m256i *)&data[s * elements + begin];
+            const __m256i a = _mm256_loadu_si256(lhs);
+            const __m256i b = _mm256_loadu_si256((const __m256i *)&rhs.data[s * elements + begin]);
+
+            const __m256i difference = _mm256_sub_epi32(a, b);
+            const __m256i total = _mm256_sub_epi32(difference, borrow);
+            const __m256i differenceUnderflow = _mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_max_epu32(a, b), a), _mm256_set1_epi32(-1));
+            const __m256i totalUnderflow = _mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_max_epu32(difference, borrow), difference), _mm256_set1_epi32(-1));
+
+            borrow = _mm256_srli_epi32(_mm256_or_si256(differenceUnderflow, totalUnderflow), 31);
+            _mm256_storeu_si256(lhs, total);
+        }
+        _mm256_storeu_si256((__m256i *)&borrows[begin], borrow);
+    }
+#elif defined(__ARM_NEON)
+    for (; begin + Lanes <= elements; begin += Lanes) {
+        uint32x4_t borrow = vdupq_n_u32(0);
+        for (size_t s = 0; s < limbs; ++s) {
+            uint32_t *lhs = &data[s * elements + begin];
+            const uint32x4_t a = vld1q_u32(lhs);
+            const uint32x4_t b = vld1q_u32(&rhs.data[s * elements + begin]);
+
+            const uint32x4_t difference = vsubq_u32(a, b);
+            const uint32x4_t total = vsubq_u32(difference, borrow);
+
+            borrow = vshrq_n_u32(vorrq_u32(vcltq_u32(a, b), vcltq_u32(difference, borrow)), 31);
+            vst1q_u32(lhs, total);
+        }
+        vst1q_u32(&borrows[begin], borrow);
+    }
+#endif
+
+    subtractScalar(rhs, borrows.data(), begin);
+}
+
+void IntegerVector::multiply(const uint32_t i, std::vector<uint32_t> &overflows) {
+    overflows.resize(elements);
+    size_t begin = 0;
+
+#if defined(__AVX2__)
+    const __m256i factor = _mm256_set1_epi32((int)i);
+    const __m256i lowerHalf = _mm256_set1_epi64x(MaxLimit);
+
+    for (; begin + Lanes <= elements; begin += Lanes) {
+        __m256i overflow = _mm256_setzero_si256();
+        for (size_t s = 0; s < limbs; ++s) {
+            __m256i *lhs = (__m256i *)&data[s * elements + begin];
+            const __m256i a = _mm256_loadu_si256(lhs);
+
+            const __m256i even = _mm256_add_epi64(_mm256_mul_epu32(a, factor), _mm256_and_si256(overflow, lowerHalf));
+            const __m256i odd = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), factor), _mm256_srli_epi64(overflow, 32));
+
+            overflow = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+            _mm256_storeu_si256(lhs, _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA));
+        }
+        _mm256_storeu_si256((__m256i *)&overflows[begin], overflow);
+    }
+#elif defined(__ARM_NEON)
+    const uint32x2_t factor = vdup_n_u32(i);
+
+    for (; begin + Lanes <= elements; begin += Lanes) {
+        uint32x4_t overflow = vdupq_n_u32(0);
+        for (size_t s = 0; s < limbs; ++s) {
+            uint32_t *lhs = &data[s * elements + begin];
+            const uint32x4_t a = vld1q_u32(lhs);
+
+            const uint64x2_t low = vmlal_u32(vmovl_u32(vget_low_u32(overflow)), vget_low_u32(a), factor);
+            const uint64x2_t high = vmlal_u32(vmovl_u32(vget_high_u32(overflow)), vget_high_u32(a), factor);
+
+            overflow = vcombine_u32(vshrn_n_u64(low, 32), vshrn_n_u64(high, 32));
+            vst1q_u32(lhs, vcombine_u32(vmovn_u64(low), vmovn_u64(high)));
+        }
+        vst1q_u32(&overflows[begin], overflow);
+    }
+#endif
+
+    multiplyScalar(i, overflows.data(), begin);
+}
+
+void IntegerVector::compare(const IntegerVector &rhs, std::vector<int32_t> &result) const {
+    result.resize(elements);
+    size_t begin = 0;
+
+#if defined(__AVX2__)
+    const __m256i sign = _mm256_set1_epi32((int)0x80000000);
+
+    for (; begin + Lanes <= elements; begin += Lanes) {
+        __m256i larger = _mm256_setzero_si256();
+        __m256i smaller = _mm256_setzero_si256();
+        for (size_t s = limbs; s > 0; --s) {
+            const __m256i a = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)&data[(s - 1) * elements + begin]), sign);
+            const __m256i b = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)&rhs.data[(s - 1) * elements + begin]), sign);
+
+            const __m256i undecided = _mm256_xor_si256(_mm256_or_si256(larger, smaller), _mm256_set1_epi32(-1));
+            larger = _mm256_or_si256(larger, _mm256_and_si256(_mm256_cmpgt_epi32(a, b), undecided));
+            smaller = _mm256_or_si256(smaller, _mm256_and_si256(_mm256_cmpgt_epi32(b, a), undecided));
+        }
+        _mm256_storeu_si256((__m256i *)&result[begin], _mm256_or_si256(_mm256_srli_epi32(larger, 31), smaller));
+    }
+#elif defined(__ARM_NEON)
+    for (; begin + Lanes <= elements; begin += Lanes) {
+        uint32x4_t larger = vdupq_n_u32(0);
+        uint32x4_t smaller = vdupq_n_u32(0);
+        for (size_t s = limbs; s > 0; --s) {
+            const uint32x4_t a = vld1q_u32(&data[(s - 1) * elements + begin]);
+            const uint32x4_t b = vld1q_u32(&rhs.data[(s - 1) * elements + begin]);
+
+            const uint32x4_t undecided = vmvnq_u32(vorrq_u32(larger, smaller));
+            larger = vorrq_u32(larger, vandq_u32(vcgtq_u32(a, b), undecided));
+            smaller = vorrq_u32(smaller, vandq_u32(vcltq_u32(a, b), undecided));
+        }
+        vst1q_s32(&result[begin], vreinterpretq_s32_u32(vorrq_u32(vshrq_n_u32(larger, 31), smaller)));
+    }
+#endif
+
+    compareScalar(rhs, result.data(), begin);
+}
+
+void IntegerVector::addScalar(const IntegerVector &rhs, uint32_t *carries, size_t begin) {
+    for (size_t t = begin; t < elements; ++t) {
+        uint64_t overflow = 0;
+        for (size_t s = 0; s < limbs; ++s) {
+            const uint64_t sum = overflow + data[s * elements + t] + rhs.data[s * elements + t];
+            data[s * elements + t] = sum % Basis;
+            overflow = sum / Basis;
+        }
+        carries[t] = (uint32_t)overflow;
+    }
+}
+
+void IntegerVector::subtractScalar(const IntegerVector &rhs, uint32_t *borrows, size_t begin) {
+    for (size_t t = begin; t < elements; ++t) {
+        uint64_t overflow = 0;
+        for (size_t s = 0; s < limbs; ++s) {
+            const uint64_t sum = Basis + data[s * elements + t] - rhs.data[s * elements + t] - overflow;
+            data[s * elements + t] = sum % Basis;
+            overflow = 1 - sum / Basis;
+        }
+        borrows[t] = (uint32_t)overflow;
+    }
+}
+
+void IntegerVector::multiplyScalar(const uint32_t i, uint32_t *overflows, size_t begin) {
+    for (size_t t = begin; t < elements; ++t) {
+        uint64_t overflow = 0;
+        for (size_t s = 0; s < limbs; ++s) {
+            const uint64_t product = (uint64_t)data[s * elements + t] * i + overflow;
+            data[s * elements + t] = product % Basis;
+            overflow = product / Basis;
+        }
+        overflows[t] = (uint32_t)overflow;
+    }
+}
+
+void IntegerVector::compareScalar(const IntegerVector &rhs, int32_t *result, size_t begin) const {
+    for (size_t t = begin; t < elements; ++t) {
+        result[t] = 0;
+        for (size_t s = limbs; s > 0 && result[t] == 0; --s) {
+            const uint32_t a = data[(s - 1) * elements + t], b = rhs.data[(s - 1) * elements + t];
+            if (a > b) result[t] = 1;
+            else if (a < b) result[t] = -1;
+        }
+    }
+}
+
+}
@@ -0,0 +1,57 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <integer.h>
+
+namespace ampc {
+
+/*
+IntegerVector stores size() unsigned integers of width() limbs each in one contiguous block.
+The limbs are interleaved, i.e. the s-th limbs of all elements are adjacent, such that the
+element wise operations run over several elements at once using AVX2 or NEON when available.
+The values are residues modulo 2^(32 * width()), the carries out of the top limb are returned
+separately.
+*/
+class IntegerVector {
+public:
+    IntegerVector(const size_t size, const size_t width) : elements(size), limbs(width), data(size * width, 0) {}
+
+    size_t size() const {return elements;}
+    size_t width() const {return limbs;}
+
+    void set(const size_t index, const Integer &value);
+    Integer get(const size_t index) const;
+
+    void add(const IntegerVector &rhs, std::vector<uint32_t> &carries);
+    void subtract(const IntegerVector &rhs, std::vector<uint32_t> &borrows);
+    void multiply(const uint32_t i, std::vector<uint32_t> &overflows);
+    void compare(const IntegerVector &rhs, std::vector<int32_t> &result) const;
+
+private:
+    size_t elements;
+    size_t limbs;
+    std::vector<uint32_t> data;
+
+    void addScalar(const IntegerVector &rhs, uint32_t *carries, size_t begin);
+    void subtractScalar(const IntegerVector &rhs, uint32_t *borrows, size_t begin);
+    void multiplyScalar(const uint32_t i, uint32_t *overflows, size_t begin);
+    void compareScalar(const IntegerVector &rhs, int32_t *result, size_t begin) const;
+};
+
+}
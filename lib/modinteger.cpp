@@ -0,0 +1,328 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <modinteger.h>
+
+#include <algorithm>
+
+namespace ampc {
+
+constexpr uint32_t WindowBits = 4;
+constexpr uint32_t SpecialFormMinBits = 64;
+
+ModContext::ModContext(const Integer &modulus) :
+    modulus(modulus),
+    limbs(modulus.absoluteValue.size()),
+    special(false),
+    shift((uint32_t)modulus.bitLength()),
+    offset(0),
+    montgomery(modulus.absoluteValue[0] % 2 == 1 && !(modulus.absoluteValue.size() == 1 && modulus.absoluteValue[0] == 1)),
+    inverse(0)
+{
+    this->modulus.abs();
+
+    if (shift >= SpecialFormMinBits) {
+        const Integer difference = (Integer(1) << shift) - this->modulus;
+        if (difference.absoluteValue.size() == 1) {
+            special = true;
+            offset = difference.absoluteValue[0];
+            montgomery = false;
+            return;
+        }
+    }
+
+    reciprocal = (Integer(1) << (uint32_t)(64 * limbs)) / this->modulus;
+
+    if (montgomery) {
+        uint32_t x = 1;
+        for (int i = 0; i < 5; ++i) x *= 2 - this->modulus.absoluteValue[0] * x;
+        inverse = 0 - x;
+
+        montgomeryOne = (Integer(1) << (uint32_t)(32 * limbs)) % this->modulus;
+        montgomerySquare = montgomeryOne * montgomeryOne;
+        barrettReduce(montgomerySquare);
+    }
+}
+
+Integer ModContext::reduce(const Integer &value) const {
+    Integer result = value;
+    result.abs();
+
+    if (special) specialReduce(result);
+    else if (result.absoluteValue.size() > 2 * limbs) result %= modulus;
+    else barrettReduce(result);
+
+    if (!value.isPositive() && !result.isZero()) result = modulus - result;
+    return result;
+}
+
+void ModContext::barrettReduce(Integer &value) const {
+    if (value < modulus) return;
+
+    Integer quotient = ((value >> (uint32_t)(32 * (limbs - 1))) * reciprocal) >> (uint32_t)(32 * (limbs + 1));
+    value -= quotient * modulus;
+
+    while (!(value < modulus)) value -= modulus;
+}
+
+void ModContext::montgomeryReduce(Integer &value) const {
+    std::vector<uint32_t> &t = value.absoluteValue;
+    const std::vector<uint32_t> &n = modulus.absoluteValue;
+    t.resize(2 * limbs + 1, 0);
+
+    for (size_t s = 0; s < limbs; ++s) {
+        const uint32_t m = t[s] * inverse;
+
+        uint64_t overflow = 0;
+        for (size_t u = 0; u < limbs; ++u) {
+            const uint64_t sum = (uint64_t)m * n[u] + t[s + u] + overflow;
+            t[s + u] = sum % Basis;
+            overflow = sum / Basis;
+        }
+        for (size_t u = s + limbs; overflow > 0; ++u) {
+            const uint64_t sum = overflow + t[u];
+            t[u] = sum % Basis;
+            overflow = sum / Basis;
+        }
+    }
+
+    t.erase(t.begin(), t.begin() + limbs);
+    while (t.back() == 0 && t.size() > 1) t.pop_back();
+
+    if (!(value < modulus)) value -= modulus;
+}
+
+/*
+With m = 2^k - c the value x = h 2^k + l is congruent to h c + l, which is repeated till x < 2^k.
+*/
+void ModContext::specialReduce(Integer &value) const {
+    std::vector<uint32_t> &t = value.absoluteValue;
+    const size_t lowLimbs = (shift + 31) / 32;
+    const uint32_t topBits = shift % 32;
+    std::vector<uint32_t> high;
+
+    while (value.bitLength() > shift) {
+        const size_t first = shift / 32;
+        high.resize(t.size() - first);
+        for (size_t s = 0; s < high.size(); ++s) {
+            const uint64_t next = first + s + 1 < t.size() ? t[first + s + 1] : 0;
+            high[s] = topBits == 0 ? t[first + s] : (uint32_t)((((next << 32) + t[first + s]) >> topBits) % Basis);
+        }
+
+        t.resize(lowLimbs);
+        if (topBits > 0) t.back() %= (uint32_t)1 << topBits;
+        t.resize(std::max(lowLimbs, high.size()) + 2, 0);
+
+        uint64_t overflow = 0;
+        size_t s = 0;
+        for (; s < high.size(); ++s) {
+            const uint64_t sum = (uint64_t)high[s] * offset + t[s] + overflow;
+            t[s] = sum % Basis;
+            overflow = sum / Basis;
+        }
+        for (; overflow > 0; ++s) {
+            const uint64_t sum = overflow + t[s];
+            t[s] = sum % Basis;
+            overflow = sum / Basis;
+        }
+
+        while (t.back() == 0 && t.size() > 1) t.pop_back();
+    }
+
+    if (!(value < modulus)) value -= modulus;
+}
+
+ModInteger::ModInteger(const ModContext &context, const Integer &i) :
+    context(&context),
+    value(context.reduce(i))
+{
+    if (context.montgomery) {
+        value *= context.montgomerySquare;
+        context.montgomeryReduce(value);
+    }
+}
+
+Integer ModInteger::toInteger() const {
+    Integer result = value;
+    if (context->montgomery) context->montgomeryReduce(result);
+    return result;
+}
+
+ModInteger ModInteger::operator -() const {
+    ModInteger result(*context);
+    if (!value.isZero()) result.value = context->modulus - value;
+    return result;
+}
+
+ModInteger ModInteger::operator +(const ModInteger &rhs) const {
+    ModInteger result(*this);
+    result += rhs;
+    return result;
+}
+
+ModInteger ModInteger::operator -(const ModInteger &rhs) const {
+    ModInteger result(*this);
+    result -= rhs;
+    return result;
+}
+
+ModInteger ModInteger::operator *(const ModInteger &rhs) const {
+    ModInteger result(*this);
+    result *= rhs;
+    return result;
+}
+
+ModInteger &ModInteger::operator +=(const ModInteger &rhs) {
+    value += rhs.value;
+    if (!(value < context->modulus)) value -= context->modulus;
+    return *this;
+}
+
+ModInteger &ModInteger::operator -=(const ModInteger &rhs) {
+    value -= rhs.value;
+    if (!value.isPositive()) value += context->modulus;
+    return *this;
+}
+
+ModInteger &ModInteger::operator *=(const ModInteger &rhs) {
+    value *= rhs.value;
+    reduceProduct();
+    return *this;
+}
+
+ModInteger &ModInteger::square() {
+    value *= value;
+    reduceProduct();
+    return *this;
+}
+
+ModInteger &ModInteger::invert() {
+    Integer r, s;
+    if (Integer::extendedEuclidianAlgo(toInteger(), context->modulus, r, s) != Integer(1)) {
+        value.set(0);
+        return *this;
+    }
+
+    *this = ModInteger(*context, r);
+    return *this;
+}
+
+ModInteger &ModInteger::power(Integer exponent) {
+    if (!exponent.isPositive()) {
+        invert();
+        exponent.abs();
+    }
+
+    std::vector<ModInteger> table(1 << WindowBits, ModInteger(*context, Integer(1)));
+    for (size_t s = 1; s < table.size(); ++s) table[s] = table[s - 1] * *this;
+
+    *this = table[0];
+
+    const size_t bits = exponent.bitLength();
+    const size_t windows = (bits + WindowBits - 1) / WindowBits;
+    for (size_t w = windows; w > 0; --w) {
+        for (uint32_t b = 0; b < WindowBits && w < windows; ++b) square();
+
+        const uint32_t d = digit(exponent, (w - 1) * WindowBits);
+        if (d > 0) *this *= table[d];
+    }
+
+    return *this;
+}
+
+/*
+Straus' method: the windows of all exponents are processed together, such that the squarings are
+shared and every base only contributes one multiplication per window. Bases and exponents are
+paired by index, surplus entries of the longer vector are ignored and no pairs at all give 1.
+*/
+ModInteger ModInteger::multiPower(const ModContext &context, const std::vector<ModInteger> &bases, const std::vector<Integer> &exponents) {
+    const ModInteger one(context, Integer(1));
+    const size_t count = std::min(bases.size(), exponents.size());
+
+    std::vector<std::vector<ModInteger>> tables(count, std::vector<ModInteger>(1 << WindowBits, one));
+    std::vector<Integer> absoluteExponents(exponents.begin(), exponents.begin() + count);
+    size_t bits = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        ModInteger base = bases[i];
+        if (!absoluteExponents[i].isPositive()) {
+            base.invert();
+            absoluteExponents[i].abs();
+        }
+
+        for (size_t s = 1; s < tables[i].size(); ++s) tables[i][s] = tables[i][s - 1] * base;
+        bits = std::max(bits, absoluteExponents[i].bitLength());
+    }
+
+    ModInteger result = one;
+    const size_t windows = (bits + WindowBits - 1) / WindowBits;
+    for (size_t w = windows; w > 0; --w) {
+        for (uint32_t b = 0; b < WindowBits && w < windows; ++b) result.square();
+
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t d = digit(absoluteExponents[i], (w - 1) * WindowBits);
+            if (d > 0) result *= tables[i][d];
+        }
+    }
+
+    return result;
+}
+
+uint32_t ModInteger::digit(const Integer &exponent, const size_t bit) {
+    if (bit / 32 >= exponent.absoluteValue.size()) return 0;
+    return (exponent.absoluteValue[bit / 32] >> (bit % 32)) % (1 << WindowBits);
+}
+
+void ModInteger::reduceProduct() {
+    if (context->special) context->specialReduce(value);
+    else if (context->montgomery) context->montgomeryReduce(value);
+    else context->barrettReduce(value);
+}
+
+FixedBase::FixedBase(const ModInteger &base, const size_t exponentBits) :
+    one(*base.context, Integer(1)),
+    top(base),
+    bits((exponentBits + WindowBits - 1) / WindowBits * WindowBits)
+{
+    const size_t digits = (1 << WindowBits) - 1;
+    table.reserve(bits / WindowBits * digits);
+
+    for (size_t w = 0; w < bits / WindowBits; ++w) {
+        table.push_back(top);
+        for (size_t d = 1; d < digits; ++d) table.push_back(table.back() * top);
+        top = table.back() * top;
+    }
+}
+
+ModInteger FixedBase::power(Integer exponent) const {
+    const bool negative = !exponent.isPositive();
+    exponent.abs();
+
+    const size_t digits = (1 << WindowBits) - 1;
+    ModInteger result = one;
+    for (size_t w = 0; w < bits / WindowBits; ++w) {
+        const uint32_t d = ModInteger::digit(exponent, w * WindowBits);
+        if (d > 0) result *= table[w * digits + d - 1];
+    }
+
+    if (exponent.bitLength() > bits) result *= ModInteger(top).power(exponent >> (uint32_t)bits);
+    if (negative) result.invert();
+
+    return result;
+}
+
+}
@@ -0,0 +1,119 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <integer.h>
+
+namespace ampc {
+
+/*
+ModContext precomputes the data to reduce modulo a fixed modulus without a general division:
+the Montgomery constants for odd moduli and the Barrett reciprocal for all moduli. Moduli of the
+special form 2^k - c with a word size c, e.g. Mersenne numbers, are reduced by shifts and additions
+instead. ModIntegers refer to their context, which therefore has to outlive them.
+*/
+class ModContext {
+public:
+    ModContext(const Integer &modulus);
+
+    const Integer &getModulus() const {return modulus;}
+    bool usesMontgomery() const {return montgomery;}
+    bool usesSpecialForm() const {return special;}
+
+    Integer reduce(const Integer &value) const;
+
+private:
+    friend class ModInteger;
+
+    Integer modulus;
+    size_t limbs;
+    Integer reciprocal;
+
+    bool special;
+    uint32_t shift;
+    uint32_t offset;
+
+    bool montgomery;
+    uint32_t inverse;
+    Integer montgomerySquare;
+    Integer montgomeryOne;
+
+    void barrettReduce(Integer &value) const;
+    void montgomeryReduce(Integer &value) const;
+    void specialReduce(Integer &value) const;
+};
+
+class ModInteger {
+public:
+    ModInteger(const ModContext &context) : context(&context), value(0) {}
+    ModInteger(const ModContext &context, const Integer &i);
+
+    const ModContext &getContext() const {return *context;}
+    Integer toInteger() const;
+
+    bool isZero() const {return value.isZero();}
+
+    bool operator ==(const ModInteger &rhs) const {return value == rhs.value;}
+    bool operator !=(const ModInteger &rhs) const {return value != rhs.value;}
+
+    ModInteger operator -() const;
+    ModInteger operator +(const ModInteger &rhs) const;
+    ModInteger operator -(const ModInteger &rhs) const;
+    ModInteger operator *(const ModInteger &rhs) const;
+
+    ModInteger &operator +=(const ModInteger &rhs);
+    ModInteger &operator -=(const ModInteger &rhs);
+    ModInteger &operator *=(const ModInteger &rhs);
+
+    ModInteger &square();
+    ModInteger &invert();
+    ModInteger &power(Integer exponent);
+
+    static ModInteger multiPower(const ModContext &context, const std::vector<ModInteger> &bases, const std::vector<Integer> &exponents);
+
+private:
+    friend class FixedBase;
+
+    const ModContext *context;
+    Integer value;
+
+    void reduceProduct();
+
+    static uint32_t digit(const Integer &exponent, const size_t bit);
+};
+
+/*
+FixedBase precomputes the powers g^(d 16^j) of a fixed base g for all digits d < 16 and all
+positions j of exponents up to the given bit length. A power is then a product of one table
+entry per digit without any squaring. Longer exponents are supported, but their high part is
+computed by an ordinary power.
+*/
+class FixedBase {
+public:
+    FixedBase(const ModInteger &base, const size_t exponentBits);
+
+    ModInteger power(Integer exponent) const;
+
+private:
+    ModInteger one;
+    std::vector<ModInteger> table;
+    ModInteger top;
+    size_t bits;
+};
+
+}
@@ -0,0 +1,38 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+namespace ampc {
+
+// extended Euclidean algorithm for a unit a modulo the word m
+inline uint32_t invertModulo(const uint32_t a, const uint32_t m) {
+    int64_t r0 = m, r1 = a % m, s0 = 0, s1 = 1;
+    while (r1 != 0) {
+        const int64_t q = r0 / r1;
+        std::swap(r0, r1);
+        r1 -= q * r0;
+        std::swap(s0, s1);
+        s1 -= q * s0;
+    }
+    return (uint32_t)(s0 < 0 ? s0 + m : s0);
+}
+
+}
@@ -0,0 +1,95 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <integer.h>
+
+namespace ampc {
+
+inline uint64_t multiplyWide(const uint64_t a, const uint64_t b, uint64_t &high) {
+    const uint64_t a0 = a % Basis, a1 = a / Basis, b0 = b % Basis, b1 = b / Basis;
+    const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    const uint64_t middle = p00 / Basis + p01 % Basis + p10 % Basis;
+    high = p11 + p01 / Basis + p10 / Basis + middle / Basis;
+    return (middle << 32) | (p00 % Basis);
+}
+
+/*
+Montgomery arithmetic modulo an odd n < 2^64 with R = 2^64 for the computations, which fit into a
+machine word.
+*/
+class Montgomery64 {
+public:
+    Montgomery64(const uint64_t n) : n(n), inverse(1) {
+        for (int i = 0; i < 6; ++i) inverse *= 2 - n * inverse;
+        inverse = 0 - inverse;
+
+        uint64_t r = (0 - n) % n;
+        one = r;
+        for (int i = 0; i < 64; ++i) r = add(r, r);
+        square = r;
+    }
+
+    uint64_t add(const uint64_t a, const uint64_t b) const {
+        const uint64_t sum = a + b;
+        return sum < a || sum >= n ? sum - n : sum;
+    }
+
+    uint64_t subtract(const uint64_t a, const uint64_t b) const {
+        return a >= b ? a - b : a - b + n;
+    }
+
+    uint64_t multiply(const uint64_t a, const uint64_t b) const {
+        uint64_t high;
+        const uint64_t low = multiplyWide(a, b, high);
+        return reduce(high, low);
+    }
+
+    uint64_t toMontgomery(const uint64_t a) const {return multiply(a % n, square);}
+
+    uint64_t power(uint64_t base, uint64_t exponent) const {
+        uint64_t result = one;
+        for (; exponent > 0; exponent /= 2) {
+            if (exponent % 2 == 1) result = multiply(result, base);
+            base = multiply(base, base);
+        }
+        return result;
+    }
+
+    const uint64_t n;
+    uint64_t inverse;
+    uint64_t one;
+    uint64_t square;
+
+private:
+    uint64_t reduce(const uint64_t high, const uint64_t low) const {
+        uint64_t productHigh;
+        multiplyWide(low * inverse, n, productHigh);
+
+        // low + low(m n) vanishes modulo 2^64, it carries unless low is zero
+        uint64_t result = high + productHigh;
+        bool overflow = result < high;
+        if (low != 0) {
+            ++result;
+            overflow |= result == 0;
+        }
+        return overflow || result >= n ? result - n : result;
+    }
+};
+
+}
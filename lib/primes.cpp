@@ -14,22 +14,199 @@ along with ampclib; if not, see http://www.gnu.org/licenses.
 #include <primes.h>
 
 #include <algorithm>
+#include <limits>
 
 namespace ampc {
 
+namespace {
+
+uint32_t powerModulo(uint64_t a, uint32_t e, const uint32_t p) {
+    uint64_t result = 1;
+    for (a %= p; e > 0; e /= 2) {
+        if (e % 2 == 1) result = result * a % p;
+        a = a * a % p;
+    }
+    return (uint32_t)result;
+}
+
+/*
+Binary algorithm for the Jacobi symbol (a / n) of an odd n: factors 2 of a are removed by (2 / n),
+odd a < n are swapped with n by quadratic reciprocity and a - n replaces a.
+*/
+int32_t jacobi(uint64_t a, uint64_t n) {
+    int32_t result = 1;
+    a %= n;
+
+    while (a != 0) {
+        for (; a % 2 == 0; a /= 2) {
+            if (n % 8 == 3 || n % 8 == 5) result = -result;
+        }
+
+        if (a < n) {
+            std::swap(a, n);
+            if (a % 4 == 3 && n % 4 == 3) result = -result;
+        }
+        a -= n;
+    }
+
+    return n == 1 ? result : 0;
+}
+
+uint32_t tonelliShanks(const uint32_t a, const uint32_t p, const uint32_t q, uint32_t m) {
+    uint32_t z = 2;
+    while (jacobi(z, p) != -1) ++z;
+
+    uint64_t c = powerModulo(z, q, p), r = powerModulo(a, (q + 1) / 2, p), t = powerModulo(a, q, p);
+    while (t != 1) {
+        uint32_t i = 0;
+        for (uint64_t u = t; u != 1; u = u * u % p) ++i;
+
+        uint64_t b = c;
+        for (uint32_t j = 0; j + i + 1 < m; ++j) b = b * b % p;
+        m = i;
+        c = b * b % p;
+        r = r * b % p;
+        t = t * c % p;
+    }
+    return (uint32_t)r;
+}
+
+/*
+Cipolla: for a non-residue w = t^2 - a the root is (t + sqrt(w))^((p + 1) / 2) in F_p(sqrt(w)).
+*/
+uint32_t cipolla(const uint32_t a, const uint32_t p) {
+    uint64_t t = 1, w;
+    do {
+        ++t;
+        w = (t * t + p - a) % p;
+    } while (jacobi(w, p) != -1);
+
+    uint64_t x = 1, y = 0, u = t, v = 1;
+    for (uint32_t e = p / 2 + 1; e > 0; e /= 2) {
+        if (e % 2 == 1) {
+            const uint64_t xu = x * u % p, yv = y * v % p * w % p;
+            y = (x * v % p + y * u % p) % p;
+            x = (xu + yv) % p;
+        }
+        const uint64_t uu = u * u % p, vv = v * v % p * w % p;
+        v = 2 * (u * v % p) % p;
+        u = (uu + vv) % p;
+    }
+    return (uint32_t)x;
+}
+
+/*
+Montgomery multiplication modulo an odd n < 2^32 with R = 2^32 and inverse = -1 / n mod R, all
+products fit into 64 bit words.
+*/
+uint32_t montgomeryMultiply(const uint64_t a, const uint64_t b, const uint32_t n, const uint32_t inverse) {
+    const uint64_t t = a * b;
+    const uint64_t m = (uint32_t)t * inverse;
+    const uint64_t r = (t >> 32) + ((m * n + (uint32_t)t) >> 32);
+    return (uint32_t)(r >= n ? r - n : r);
+}
+
+/*
+Miller-Rabin to the bases 2, 7 and 61, which is deterministic for odd n < 4759123141.
+*/
+bool millerRabin(const uint32_t n) {
+    uint32_t inverse = n;
+    for (int i = 0; i < 4; ++i) inverse *= 2 - n * inverse;
+    inverse = 0 - inverse;
+
+    const uint32_t one = (uint32_t)(((uint64_t)1 << 32) % n), minusOne = n - one;
+    uint32_t d = n - 1, s = 0;
+    for (; d % 2 == 0; d /= 2) ++s;
+
+    for (const uint64_t a : {2, 7, 61}) {
+        uint32_t base = (uint32_t)((a << 32) % n), x = one;
+        for (uint32_t e = d; e > 0; e /= 2) {
+            if (e % 2 == 1) x = montgomeryMultiply(x, base, n, inverse);
+            base = montgomeryMultiply(base, base, n, inverse);
+        }
+        if (x == one || x == minusOne) continue;
+
+        for (uint32_t r = 1; r < s && x != minusOne; ++r) x = montgomeryMultiply(x, x, n, inverse);
+        if (x != minusOne) return false;
+    }
+    return true;
+}
+
+const uint32_t WheelPeriod = 105;
+const size_t TrialDivisors = 16;
+const uint32_t SegmentSize = 32768;
+
+/*
+Segmented sieve of Eratosthenes over the odd numbers 2k + 1 <= limit: every segment of SegmentSize
+bytes stays in the L1 cache and is initialized by tiling the wheel pattern of 3 * 5 * 7, so only
+primes from 11 on are crossed off.
+*/
+void sieve(const uint32_t limit, std::vector<uint32_t> &primes) {
+    primes.clear();
+    for (const uint32_t p : {2, 3, 5, 7}) {
+        if (p <= limit) primes.push_back(p);
+    }
+    if (limit < 11) return;
+
+    uint8_t wheel[WheelPeriod];
+    for (uint32_t k = 0; k < WheelPeriod; ++k) {
+        const uint32_t n = 2 * k + 1;
+        wheel[k] = n % 3 != 0 && n % 5 != 0 && n % 7 != 0;
+    }
+
+    uint32_t root = (uint32_t)std::sqrt((double)limit);
+    while ((uint64_t)root * root > limit) --root;
+    while ((uint64_t)(root + 1) * (root + 1) <= limit) ++root;
+
+    std::vector<uint32_t> sievingPrimes;
+    std::vector<uint64_t> multiples;
+    std::vector<bool> composite(root / 2 + 1, false);
+    for (uint32_t i = 3; i <= root; i += 2) {
+        if (composite[i / 2]) continue;
+        for (uint32_t j = i * i; j <= root; j += 2 * i) composite[j / 2] = true;
+        if (i < 11) continue;
+        sievingPrimes.push_back(i);
+        multiples.push_back((uint64_t)i * i / 2);
+    }
+
+    const uint64_t count = ((uint64_t)limit - 1) / 2 + 1;
+    std::vector<uint8_t> segment(SegmentSize);
+    for (uint64_t low = 0; low < count; low += SegmentSize) {
+        const uint32_t size = (uint32_t)std::min<uint64_t>(SegmentSize, count - low);
+
+        for (uint32_t k = 0, w = low % WheelPeriod; k < size; ++k) {
+            segment[k] = wheel[w];
+            if (++w == WheelPeriod) w = 0;
+        }
+
+        for (size_t j = 0; j < sievingPrimes.size(); ++j) {
+            uint64_t m = multiples[j];
+            for (; m < low + size; m += sievingPrimes[j]) segment[m - low] = 0;
+            multiples[j] = m;
+        }
+
+        for (uint32_t k = low == 0 ? 1 : 0; k < size; ++k) {
+            if (segment[k]) primes.push_back((uint32_t)(2 * (low + k) + 1));
+        }
+    }
+}
+
+}
+
 const Primes &Primes::getInstance() {
     static Primes p;
     return p;
 }
 
 bool Primes::isPrime(const uint32_t i) const {
-    if (i <= std::numeric_limits<uint16_t>::max())
-        return std::find(primes.begin(), primes.end(), i) != primes.end();
+    if (i % 2 == 0) return i == 2;
+    if (i <= std::numeric_limits<uint16_t>::max()) return (oddPrimes[i / 128] >> (i / 2 % 64)) & 1;
 
-    for (const uint32_t prime : primes) {
-        if (i % prime == 0) return false;
+    for (size_t j = 1; j < TrialDivisors; ++j) {
+        if (i % primes[j] == 0) return false;
     }
-    return true;
+
+    return millerRabin(i);
 }
 
 uint32_t Primes::getPrimeFactor(const uint32_t i) const {
@@ -43,6 +220,20 @@ uint32_t Primes::getPrimeFactor(const uint32_t i) const {
     return i;
 }
 
+void Primes::getPrimes(const uint32_t limit, std::vector<uint32_t> &primes) {
+    primes.clear();
+
+    if (limit <= std::numeric_limits<uint16_t>::max()) {
+        for (const uint32_t p : getInstance().primes) {
+            if (p > limit) break;
+            primes.push_back(p);
+        }
+        return;
+    }
+
+    sieve(limit, primes);
+}
+
 void Primes::getPrimeFactors(uint32_t i, std::vector<uint32_t> &primeFactors) {
     primeFactors.clear();
 
@@ -196,56 +387,105 @@ int32_t Primes::lambda(uint32_t i) {
 
 int32_t Primes::legendreSymbol(const uint32_t a, const uint32_t b) {
     if (!getInstance().isPrime(b)) return 0;
+    if (b == 2) return a % 2;
 
-    uint64_t r = a % b;
+    return jacobi(a, b);
+}
 
-    if (r == 0) return 0;
+/*
+For even b the factor 2 contributes 1 for odd a and 0 for even a, b = 0 gives 1.
+*/
+int32_t Primes::jacobiSymbol(const uint32_t a, uint32_t b) {
+    if (b == 0) return 1;
 
-    if (b == 2) return 1;
+    if (b % 2 == 0) {
+        if (a % 2 == 0) return 0;
+        while (b % 2 == 0) b /= 2;
+    }
 
-    uint32_t exponent = (b - 1) / 2;
-    uint64_t power = 1;
+    return jacobi(a, b);
+}
 
-    for (uint32_t c = 0; c < exponent; ++c) {
-        power *= r;
-        power %= b;
+int32_t Primes::kroneckerSymbol(const uint64_t a, uint64_t b) {
+    if (b == 0) return a == 1 ? 1 : 0;
+    if (a % 2 == 0 && b % 2 == 0) return 0;
+
+    // (a / 2) = 1 for a = 1, 7 mod 8 and -1 for a = 3, 5 mod 8
+    int32_t result = 1;
+    for (; b % 2 == 0; b /= 2) {
+        if (a % 8 == 3 || a % 8 == 5) result = -result;
     }
 
-    return power == 1 ? 1 : -1;
+    return result * jacobi(a, b);
 }
 
-int32_t Primes::jacobiSymbol(const uint32_t a, const uint32_t b) {
-    std::vector<uint32_t> primeFactors;
-    getPrimeFactorsWithMultiplicity(b, primeFactors);
+/*
+Returns the smaller square root of a modulo the prime p or p, if a is no quadratic residue. Tonelli-Shanks
+needs s^2 multiplications for p - 1 = 2^s q, so primes with large s are handled by Cipolla's method.
+*/
+uint32_t Primes::sqrtModulo(uint32_t a, const uint32_t p) {
+    if (!getInstance().isPrime(p)) return p;
+    a %= p;
+    if (p == 2 || a == 0) return a;
+    if (jacobi(a, p) != 1) return p;
 
-    int32_t result = 1;
+    uint32_t q = p - 1, s = 0;
+    for (; q % 2 == 0; q /= 2) ++s;
 
-    for (const uint32_t p : primeFactors) {
-        result *= legendreSymbol(a, p);
-        if (result == 0) break;
+    const uint32_t root = s * (s - 1) > 8 * 32 + 20 ? cipolla(a, p) : tonelliShanks(a, p, q, s);
+    return std::min(root, p - root);
+}
+
+/*
+Returns the multiplicative order of a modulo n or 0, if a is no unit. Starting from phi(n) each
+prime factor q is removed as long as a^(order / q) = 1.
+*/
+uint32_t Primes::order(uint32_t a, const uint32_t n) {
+    if (n < 2) return n;
+
+    a %= n;
+    uint32_t u = n, v = a;
+    while (v != 0) {
+        const uint32_t r = u % v;
+        u = v;
+        v = r;
+    }
+    if (u != 1) return 0;
+
+    uint32_t result = eulerPhi(n);
+    std::vector<uint32_t> primeFactors;
+    getPrimeFactors(result, primeFactors);
+
+    for (const uint32_t q : primeFactors) {
+        while (result % q == 0 && powerModulo(a, result / q, n) == 1) result /= q;
     }
 
     return result;
 }
 
-Primes::Primes() : primes{2, 3} {
-    for (uint32_t i = 4; i <= std::numeric_limits<uint16_t>::max(); ++i) {
-        checkPrime(i);
-    }
+/*
+Returns the smallest primitive root modulo the prime p or 0, if p is not prime. g is a primitive
+root, if g^((p - 1) / q) != 1 for all prime factors q of p - 1.
+*/
+uint32_t Primes::primitiveRoot(const uint32_t p) {
+    if (!getInstance().isPrime(p)) return 0;
+    if (p == 2) return 1;
 
-    uint32_t i = std::numeric_limits<uint16_t>::max();
-    do {
-        ++i;
-    } while (!checkPrime(i));
+    std::vector<uint32_t> primeFactors;
+    getPrimeFactors(p - 1, primeFactors);
+
+    uint32_t g = 2;
+    while (std::any_of(primeFactors.begin(), primeFactors.end(), [g, p](const uint32_t q) {return powerModulo(g, (p - 1) / q, p) == 1;})) ++g;
+
+    return g;
 }
 
-bool Primes::checkPrime(uint32_t i) {
-    for (uint32_t prime : primes) {
-        if (i % prime == 0) return false;
-    }
+Primes::Primes() {
+    // all primes below 2^16 and the next one, 65537
+    sieve(std::numeric_limits<uint16_t>::max() + 2, primes);
 
-    primes.push_back(i);
-    return true;
+    oddPrimes.assign(512, 0);
+    for (size_t j = 1; j + 1 < primes.size(); ++j) oddPrimes[primes[j] / 128] |= (uint64_t)1 << (primes[j] / 2 % 64);
 }
 
 }
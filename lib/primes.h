@@ -26,6 +26,8 @@ public:
 
     uint32_t getPrimeFactor(const uint32_t i) const;
 
+    static void getPrimes(const uint32_t limit, std::vector<uint32_t> &primes);
+
     static void getPrimeFactors(uint32_t i, std::vector<uint32_t> &primeFactors);
     static void getPrimeFactorsWithMultiplicity(uint32_t i, std::vector<uint32_t> &primeFactors);
     static void getFactors(uint32_t i, std::vector<uint32_t> &factors);
@@ -37,18 +39,21 @@ public:
     uint32_t nextPrime(const uint16_t) const;
     static int32_t lambda(uint32_t i);
     static int32_t legendreSymbol(const uint32_t a, const uint32_t b);
-    static int32_t jacobiSymbol(const uint32_t a, const uint32_t b);
+    static int32_t jacobiSymbol(const uint32_t a, uint32_t b);
+    static int32_t kroneckerSymbol(const uint64_t a, uint64_t b);
+    static uint32_t sqrtModulo(uint32_t a, const uint32_t p);
+    static uint32_t order(uint32_t a, const uint32_t n);
+    static uint32_t primitiveRoot(const uint32_t p);
 
 private:
     std::vector<uint32_t> primes;
+    std::vector<uint64_t> oddPrimes; // bit (i / 2) % 64 of word i / 128 is set iff the odd i < 2^16 is prime
 
     Primes();
 
     ~Primes() = default;
     Primes(const Primes&) = delete;
     Primes &operator=(const Primes&) = delete;
-
-    bool checkPrime(uint32_t i);
 };
 
 }
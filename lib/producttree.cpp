@@ -0,0 +1,55 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <producttree.h>
+#include <threadpool.h>
+
+namespace ampc {
+
+ProductTree::ProductTree(const std::vector<Integer> &leaves) : levels{leaves} {
+    build();
+}
+
+ProductTree::ProductTree(const std::vector<uint32_t> &leaves) : levels(1) {
+    levels.front().reserve(leaves.size());
+    for (const uint32_t leaf : leaves) levels.front().push_back(Integer(leaf));
+    build();
+}
+
+void ProductTree::build() {
+    if (levels.front().empty()) {
+        levels.push_back(std::vector<Integer>{Integer(1)});
+        return;
+    }
+
+    while (levels.back().size() > 1) {
+        const std::vector<Integer> &lower = levels.back();
+        const size_t size = lower.size();
+
+        std::vector<Integer> upper((size + 1) / 2);
+        std::vector<std::function<void()>> tasks;
+        for (size_t s = 0; s + 1 < size; s += 2) {
+            tasks.push_back([&upper, &lower, s]() {upper[s / 2] = lower[s] * lower[s + 1];});
+        }
+        ThreadPool::getInstance().run(tasks);
+        if (size % 2 == 1) upper.back() = lower.back();
+
+        levels.push_back(upper);
+    }
+}
+
+}
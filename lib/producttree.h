@@ -0,0 +1,47 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <integer.h>
+
+namespace ampc {
+
+/*
+ProductTree is the balanced binary tree of products over its leaves. Level 0 holds the leaves,
+node j of level l + 1 is the product of the nodes 2j and 2j + 1 of level l, where an unpaired
+last node is taken over unchanged. The last level holds the product of all leaves. The products
+of one level are computed in parallel by the ThreadPool.
+*/
+class ProductTree {
+public:
+    ProductTree(const std::vector<Integer> &leaves);
+    ProductTree(const std::vector<uint32_t> &leaves);
+
+    size_t size() const {return levels.front().size();}
+    size_t height() const {return levels.size();}
+
+    const std::vector<Integer> &level(const size_t l) const {return levels[l];}
+    const Integer &root() const {return levels.back().front();}
+
+private:
+    std::vector<std::vector<Integer>> levels;
+
+    void build();
+};
+
+}
@@ -0,0 +1,410 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <quadraticsieve.h>
+#include <modularinverse.h>
+#include <primes.h>
+#include <threadpool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <map>
+
+namespace ampc {
+
+namespace {
+
+struct Parameters {
+    uint32_t digits;
+    uint32_t baseSize;
+    uint32_t halfWidth;
+};
+
+// Measured on one thread 55 digits take seconds and 65 digits more than a minute.
+constexpr Parameters Table[] = {
+    {20, 100, 16384},
+    {30, 200, 32768},
+    {40, 450, 32768},
+    {50, 1100, 65536},
+    {60, 2400, 65536},
+    {70, 5000, 98304}
+};
+
+// The primes below are not sieved, but found by trial division.
+constexpr uint32_t SieveStart = 40;
+constexpr uint32_t ExtraRelations = 24;
+constexpr uint32_t LargePrimeFactor = 64;
+
+// Small primes in A give more polynomials per A, but the primes of A are not sieved.
+constexpr double CoefficientPrimeBits = 11.5;
+
+constexpr uint32_t BlockSize = 32768;
+constexpr double ThresholdSlack = 4;
+
+}
+
+QuadraticSieve::QuadraticSieve(const Integer &n, const uint64_t seed) :
+    n(n),
+    generator(seed),
+    trivialFactor(1)
+{
+    const uint32_t digits = (uint32_t)(n.bitLength() * std::log10(2.0)) + 1;
+    size_t row = 0;
+    while (row + 1 < sizeof(Table) / sizeof(Table[0]) && Table[row].digits < digits) ++row;
+    halfWidth = Table[row].halfWidth;
+    const uint32_t baseSize = Table[row].baseSize;
+
+    std::vector<uint32_t> primes;
+    for (uint32_t limit = 32 * baseSize; base.size() < baseSize; limit *= 2) {
+        base.clear();
+        roots.clear();
+        Primes::getPrimes(limit, primes);
+
+        for (const uint32_t p : primes) {
+            const uint32_t r = n % p;
+            if (r == 0) {
+                trivialFactor = Integer(p);
+                return;
+            }
+            const uint32_t root = Primes::sqrtModulo(r, p);
+            if (root == p) continue;
+
+            base.push_back(p);
+            roots.push_back(root);
+            if (base.size() == baseSize) break;
+        }
+    }
+
+    largePrimeBound = base.back() * LargePrimeFactor;
+
+    // |Q(x)| < M sqrt(n / 2), the logarithms are scaled such that the sieve bytes do not overflow
+    const double logQ = std::log2((double)halfWidth) + n.bitLength() / 2.0 - 0.5;
+    const double scale = std::min(1.0, 96.0 / logQ);
+    for (const uint32_t p : base) logs.push_back((uint8_t)std::lround(std::log2(p) * scale));
+
+    const double threshold = (logQ - std::log2((double)base.back()) - std::log2((double)largePrimeBound) + ThresholdSlack) * scale;
+    sieveOffset = (uint8_t)(128 - std::min(120.0, std::max(8.0, std::round(threshold))));
+
+    target = n * 2;
+    target.isqrt();
+    target /= halfWidth;
+}
+
+Integer QuadraticSieve::factor() {
+    if (trivialFactor != 1) return trivialFactor == n ? n : trivialFactor;
+
+    size_t needed = base.size() + 1 + ExtraRelations;
+    std::vector<Relation> relations;
+    std::map<uint32_t, Relation> partials;
+
+    for (uint32_t round = 0; round < 4; ++round) {
+        while (relations.size() < needed) {
+            const size_t batch = ThreadPool::getInstance().size();
+            std::vector<std::vector<uint32_t>> coefficients(batch);
+            for (auto &indices : coefficients) {
+                if (!chooseCoefficient(indices)) return n;
+            }
+
+            std::vector<std::vector<Relation>> found(batch);
+            std::vector<std::function<void()>> tasks;
+            for (size_t t = 0; t < batch; ++t) {
+                tasks.push_back([this, t, &coefficients, &found]() {sieve(coefficients[t], found[t]);});
+            }
+            ThreadPool::getInstance().run(tasks);
+
+            for (const auto &f : found) {
+                for (const Relation &relation : f) {
+                    if (relation.largePrime == 0) {
+                        relations.push_back(relation);
+                        continue;
+                    }
+
+                    // two relations with the same large prime L give one with the square L^2
+                    const auto partial = partials.find(relation.largePrime);
+                    if (partial == partials.end()) partials.insert(std::make_pair(relation.largePrime, relation));
+                    else if (partial->second.y != relation.y) {
+                        Relation combined = relation;
+                        combined.y *= partial->second.y;
+                        combined.factors.insert(combined.factors.end(), partial->second.factors.begin(), partial->second.factors.end());
+                        relations.push_back(combined);
+                    }
+                }
+            }
+
+            std::sort(relations.begin(), relations.end());
+            relations.erase(std::unique(relations.begin(), relations.end()), relations.end());
+        }
+
+        const Integer g = combine(relations);
+        if (g != n) return g;
+
+        needed += ExtraRelations;
+    }
+
+    return n;
+}
+
+/*
+Chooses s primes of the factor base, whose product A is close to sqrt(2 n) / M: s - 1 of them at
+random around the s-th root of this target, the last one such that the product fits best.
+*/
+bool QuadraticSieve::chooseCoefficient(std::vector<uint32_t> &indices) {
+    const double targetBits = std::log2(target.toDouble());
+    const size_t first = std::min<size_t>(2, base.size());
+    if (base.size() < 8 || targetBits < 3 * std::log2(base[first])) return false;
+
+    const double idealBits = std::min(CoefficientPrimeBits, std::log2(base[base.size() / 2]));
+    const uint32_t s = std::max<uint32_t>(2, (uint32_t)std::lround(targetBits / idealBits));
+    const double primeBits = targetBits / s;
+
+    size_t low = first, high = base.size() - 1;
+    while (low < high && std::log2(base[low]) < primeBits - 1) ++low;
+    while (high > low && std::log2(base[high]) > primeBits + 1) --high;
+    if (high - low < 2 * s) {
+        low = std::max<size_t>(first, low > 2 * s ? low - 2 * s : 0);
+        high = std::min<size_t>(base.size() - 1, high + 2 * s);
+    }
+
+    for (uint32_t attempt = 0; attempt < 100; ++attempt) {
+        indices.clear();
+        double bits = 0;
+        while (indices.size() + 1 < s) {
+            const uint32_t i = (uint32_t)low + generator.below((uint32_t)(high - low + 1));
+            if (std::find(indices.begin(), indices.end(), i) != indices.end()) continue;
+            indices.push_back(i);
+            bits += std::log2(base[i]);
+        }
+
+        size_t best = base.size();
+        for (size_t i = first; i < base.size(); ++i) {
+            if (std::find(indices.begin(), indices.end(), i) != indices.end()) continue;
+            if (best == base.size() || std::abs(bits + std::log2(base[i]) - targetBits) < std::abs(bits + std::log2(base[best]) - targetBits)) best = i;
+        }
+        if (best == base.size()) return false;
+        indices.push_back((uint32_t)best);
+
+        std::sort(indices.begin(), indices.end());
+        if (std::find(usedCoefficients.begin(), usedCoefficients.end(), indices) == usedCoefficients.end()) {
+            usedCoefficients.push_back(indices);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+B = B_1 + ... + B_s with B_l = (A / q_l) gamma_l and B^2 = n mod A. The other polynomials of the
+same A flip the signs of B_2, ..., B_s in Gray code order, which moves the sieve roots by
+precomputed amounts.
+*/
+void QuadraticSieve::sieve(const std::vector<uint32_t> &indices, std::vector<Relation> &relations) const {
+    const size_t s = indices.size(), size = base.size();
+
+    std::vector<Integer> q;
+    for (const uint32_t i : indices) q.push_back(Integer(base[i]));
+    const Integer a = Integer::product(q);
+
+    std::vector<Integer> parts;
+    Integer b(0);
+    for (size_t l = 0; l < s; ++l) {
+        const uint32_t p = base[indices[l]];
+        const Integer cofactor = a / p;
+        uint32_t gamma = (uint32_t)((uint64_t)roots[indices[l]] * invertModulo(cofactor % p, p) % p);
+        if (gamma > p / 2) gamma = p - gamma;
+        parts.push_back(cofactor * gamma);
+        b += parts.back();
+    }
+
+    std::vector<bool> divides(size, false);
+    for (const uint32_t i : indices) divides[i] = true;
+
+    std::vector<uint32_t> inverse(size, 0), root1(size, 0), root2(size, 0);
+    std::vector<uint32_t> start1(size, 0), start2(size, 0), next1(size, 0), next2(size, 0);
+    std::vector<std::vector<uint32_t>> shifts(s, std::vector<uint32_t>(size, 0));
+    for (size_t i = 0; i < size; ++i) {
+        if (divides[i]) continue;
+
+        const uint32_t p = base[i];
+        inverse[i] = invertModulo(a % p, p);
+        for (size_t l = 0; l < s; ++l) shifts[l][i] = (uint32_t)(2 * (uint64_t)(parts[l] % p) * inverse[i] % p);
+
+        const uint64_t bp = b % p;
+        root1[i] = (uint32_t)((roots[i] + p - bp) * inverse[i] % p);
+        root2[i] = (uint32_t)((2 * (uint64_t)p - roots[i] - bp) % p * inverse[i] % p);
+    }
+
+    const uint32_t width = 2 * halfWidth;
+
+    std::vector<int32_t> signs(s, 1);
+    std::vector<uint8_t> sieveArray(width);
+
+    for (uint32_t k = 0; k < (1u << (s - 1)); ++k) {
+        if (k > 0) {
+            size_t v = 1;
+            while ((k & (1u << (v - 1))) == 0) ++v;
+
+            if (signs[v] > 0) b -= parts[v] * 2;
+            else b += parts[v] * 2;
+
+            for (size_t i = 0; i < size; ++i) {
+                if (divides[i]) continue;
+                const uint32_t p = base[i], shift = signs[v] > 0 ? shifts[v][i] : (p - shifts[v][i]) % p;
+                root1[i] = (uint32_t)(((uint64_t)root1[i] + shift) % p);
+                root2[i] = (uint32_t)(((uint64_t)root2[i] + shift) % p);
+            }
+            signs[v] = -signs[v];
+        }
+
+        const Integer c = (b * b - n) / a;
+
+        // x = root mod p corresponds to the positions j = root + M mod p of the sieve array
+        for (size_t i = 0; i < size; ++i) {
+            if (divides[i]) continue;
+
+            const uint32_t p = base[i], offset = halfWidth % p;
+            start1[i] = next1[i] = (root1[i] + offset) % p;
+            start2[i] = next2[i] = (root2[i] + offset) % p;
+        }
+
+        // The array starts at 128 - threshold, such that the candidates have the highest bit set.
+        // The values are copied to locals, since the compiler has to assume that the bytes alias them.
+        std::fill(sieveArray.begin(), sieveArray.end(), sieveOffset);
+        uint8_t *array = sieveArray.data();
+        for (uint32_t block = 0; block < width; block += BlockSize) {
+            const uint32_t end = std::min(width, block + BlockSize);
+            for (size_t i = 0; i < size; ++i) {
+                const uint32_t p = base[i];
+                if (p < SieveStart || divides[i]) continue;
+
+                const uint8_t log = logs[i];
+                uint32_t j = next1[i];
+                for (; j < end; j += p) array[j] += log;
+                next1[i] = j;
+
+                if (start2[i] == start1[i]) continue;
+                for (j = next2[i]; j < end; j += p) array[j] += log;
+                next2[i] = j;
+            }
+        }
+
+        for (uint32_t j = 0; j < width; ++j) {
+            if (j % 8 == 0) {
+                uint64_t word;
+                std::memcpy(&word, &sieveArray[j], sizeof(word));
+                if ((word & 0x8080808080808080) == 0) {
+                    j += 7;
+                    continue;
+                }
+            }
+            if (sieveArray[j] < 128) continue;
+
+            const int64_t x = (int64_t)j - halfWidth;
+            Integer value = (a * Integer(x) + b * 2) * Integer(x) + c;
+
+            Relation relation;
+            relation.largePrime = 0;
+            if (!value.isPositive()) relation.factors.push_back(0);
+            value.abs();
+            if (value.isZero()) continue;
+
+            for (size_t i = 0; i < size; ++i) {
+                const uint32_t p = base[i];
+                if (!divides[i]) {
+                    const uint32_t r = j % p;
+                    if (r != start1[i] && r != start2[i]) continue;
+                }
+                else relation.factors.push_back((uint32_t)i + 1);
+
+                for (std::pair<Integer, uint32_t> division = value.divideWithRest(p); division.second == 0; division = value.divideWithRest(p)) {
+                    value = division.first;
+                    relation.factors.push_back((uint32_t)i + 1);
+                }
+            }
+
+            if (value != 1) {
+                if (!(value < Integer(largePrimeBound))) continue;
+                relation.largePrime = value.toUnsignedInt();
+            }
+
+            relation.y = a * Integer(x) + b;
+            relations.push_back(relation);
+        }
+    }
+}
+
+/*
+Gaussian elimination of the exponent vectors modulo 2. Every dependency gives X^2 = Z^2 mod n,
+where Z contains the large primes of the combined relations once, and gcd(X - Z, n) is tried
+as factor.
+*/
+Integer QuadraticSieve::combine(const std::vector<Relation> &relations) const {
+    const size_t rows = relations.size(), columns = base.size() + 1;
+    const size_t words = (columns + 63) / 64, historyWords = (rows + 63) / 64;
+
+    std::vector<std::vector<uint64_t>> matrix(rows, std::vector<uint64_t>(words, 0));
+    std::vector<std::vector<uint64_t>> history(rows, std::vector<uint64_t>(historyWords, 0));
+    for (size_t r = 0; r < rows; ++r) {
+        for (const uint32_t f : relations[r].factors) matrix[r][f / 64] ^= (uint64_t)1 << (f % 64);
+        history[r][r / 64] = (uint64_t)1 << (r % 64);
+    }
+
+    size_t rank = 0;
+    for (size_t column = 0; column < columns && rank < rows; ++column) {
+        const size_t word = column / 64;
+        const uint64_t bit = (uint64_t)1 << (column % 64);
+
+        size_t pivot = rank;
+        while (pivot < rows && (matrix[pivot][word] & bit) == 0) ++pivot;
+        if (pivot == rows) continue;
+
+        std::swap(matrix[pivot], matrix[rank]);
+        std::swap(history[pivot], history[rank]);
+
+        for (size_t r = rank + 1; r < rows; ++r) {
+            if ((matrix[r][word] & bit) == 0) continue;
+            for (size_t w = word; w < words; ++w) matrix[r][w] ^= matrix[rank][w];
+            for (size_t w = 0; w < historyWords; ++w) history[r][w] ^= history[rank][w];
+        }
+        ++rank;
+    }
+
+    for (size_t d = rank; d < rows; ++d) {
+        Integer x(1), z(1);
+        std::vector<uint32_t> exponents(columns, 0);
+
+        for (size_t r = 0; r < rows; ++r) {
+            if ((history[d][r / 64] & ((uint64_t)1 << (r % 64))) == 0) continue;
+            x = x * relations[r].y % n;
+            if (relations[r].largePrime != 0) z = z * relations[r].largePrime % n;
+            for (const uint32_t f : relations[r].factors) ++exponents[f];
+        }
+
+        for (size_t c = 1; c < columns; ++c) {
+            for (uint32_t e = 0; e < exponents[c] / 2; ++e) z = z * base[c - 1] % n;
+        }
+
+        const Integer g = Integer::gcd(x - z, n);
+        if (g != 1 && g != n) return g;
+    }
+
+    return n;
+}
+
+}
@@ -0,0 +1,72 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <integer.h>
+#include <randomgenerator.h>
+
+#include <vector>
+
+namespace ampc {
+
+/*
+QuadraticSieve searches a proper factor of an odd composite n, which is no perfect power, by the
+self initializing quadratic sieve. The factor base consists of the primes p of the Primes class
+with (n / p) = 1. For every leading coefficient A, which is a product of factor base primes, the
+2^(s-1) polynomials Q(x) = A x^2 + 2 B x + C are sieved with logarithms over [-M, M), each A
+being one task for the ThreadPool. The smooth relations (A x + B)^2 = A Q(x) mod n and pairs of
+relations with the same large prime outside the factor base are combined by Gaussian elimination
+over GF(2). The parameters are tuned for up to 65 digits, Factorization::quadraticSieve() does not
+pass larger n.
+*/
+class QuadraticSieve {
+public:
+    QuadraticSieve(const Integer &n, const uint64_t seed = 0);
+
+    Integer factor();
+
+private:
+    struct Relation {
+        Integer y;
+        std::vector<uint32_t> factors;
+        uint32_t largePrime;
+
+        bool operator <(const Relation &rhs) const {return y < rhs.y;}
+        bool operator ==(const Relation &rhs) const {return y == rhs.y;}
+    };
+
+    Integer n;
+    RandomGenerator generator;
+
+    uint32_t halfWidth;
+    uint32_t largePrimeBound;
+    std::vector<uint32_t> base;
+    std::vector<uint32_t> roots;
+    std::vector<uint8_t> logs;
+    uint8_t sieveOffset;
+    Integer trivialFactor;
+
+    Integer target;
+    std::vector<std::vector<uint32_t>> usedCoefficients;
+
+    bool chooseCoefficient(std::vector<uint32_t> &indices);
+    void sieve(const std::vector<uint32_t> &indices, std::vector<Relation> &relations) const;
+    Integer combine(const std::vector<Relation> &relations) const;
+};
+
+}
@@ -0,0 +1,106 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <randomgenerator.h>
+
+namespace ampc {
+
+namespace {
+
+uint64_t rotate(const uint64_t x, const int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+}
+
+RandomGenerator::RandomGenerator(const uint64_t seed) {
+    this->seed(seed);
+}
+
+void RandomGenerator::seed(uint64_t seed) {
+    // splitmix64 spreads the seed over the state, which must not be all zero
+    for (uint64_t &s : state) {
+        seed += 0x9E3779B97F4A7C15;
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+        s = z ^ (z >> 31);
+    }
+}
+
+uint64_t RandomGenerator::next() {
+    const uint64_t result = rotate(state[1] * 5, 7) * 9;
+    const uint64_t t = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotate(state[3], 45);
+
+    return result;
+}
+
+uint32_t RandomGenerator::below(const uint32_t bound) {
+    if (bound == 0) return 0;
+
+    // Lemire: the high word of x * bound is uniform once the biased low words are rejected
+    uint64_t product = (next() >> 32) * bound;
+    if ((uint32_t)product < bound) {
+        const uint32_t threshold = (uint32_t)(-bound) % bound;
+        while ((uint32_t)product < threshold) product = (next() >> 32) * bound;
+    }
+    return (uint32_t)(product >> 32);
+}
+
+Integer RandomGenerator::below(const Integer &bound) {
+    Integer value;
+    if (!bound.positive || bound.isZero()) return value;
+
+    const uint32_t length = (uint32_t)bound.bitLength();
+    do {
+        fill(value, length, false);
+    } while (!(value < bound));
+
+    return value;
+}
+
+Integer RandomGenerator::bits(const uint32_t length) {
+    Integer value;
+    if (length == 0) return value;
+
+    fill(value, length, true);
+    return value;
+}
+
+void RandomGenerator::fill(Integer &value, const uint32_t length, const bool exact) {
+    const size_t size = (length + 31) / 32;
+    value.absoluteValue.resize(size);
+
+    for (size_t s = 0; s < size; s += 2) {
+        const uint64_t word = next();
+        value.absoluteValue[s] = (uint32_t)word;
+        if (s + 1 < size) value.absoluteValue[s + 1] = (uint32_t)(word >> 32);
+    }
+    if (length % 32 != 0) value.absoluteValue.back() &= (1u << (length % 32)) - 1;
+    if (exact) value.absoluteValue.back() |= 1u << ((length - 1) % 32);
+
+    while (value.absoluteValue.size() > 1 && value.absoluteValue.back() == 0) value.absoluteValue.pop_back();
+}
+
+}
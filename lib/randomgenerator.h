@@ -0,0 +1,49 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <integer.h>
+
+#include <cstdint>
+
+namespace ampc {
+
+/*
+RandomGenerator draws Integers by filling their limbs from a seeded xoshiro256** engine. It is
+fast and reproducible, but not suitable for cryptography. An instance must not be shared between
+threads without synchronization.
+*/
+class RandomGenerator {
+public:
+    explicit RandomGenerator(const uint64_t seed = 0);
+
+    void seed(uint64_t seed);
+
+    uint64_t next();
+    uint32_t below(const uint32_t bound);
+
+    Integer below(const Integer &bound);
+    Integer bits(const uint32_t length);
+
+private:
+    uint64_t state[4];
+
+    void fill(Integer &value, const uint32_t length, const bool exact);
+};
+
+}
@@ -0,0 +1,60 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <remaindertree.h>
+
+namespace ampc {
+
+RemainderTree::RemainderTree(const std::vector<Integer> &moduli) : tree(moduli) {
+    prepare();
+}
+
+RemainderTree::RemainderTree(const std::vector<uint32_t> &moduli) : tree(moduli) {
+    prepare();
+}
+
+void RemainderTree::prepare() {
+    contexts.resize(tree.height());
+    for (size_t l = 0; l < tree.height(); ++l) {
+        for (const Integer &node : tree.level(l)) contexts[l].push_back(ModContext(node));
+    }
+}
+
+void RemainderTree::remainders(const Integer &x, std::vector<Integer> &result) const {
+    result.assign(1, contexts.back().front().reduce(x));
+
+    for (size_t l = tree.height() - 1; l > 0; --l) {
+        const std::vector<ModContext> &nodes = contexts[l - 1];
+        const size_t size = nodes.size();
+
+        std::vector<Integer> lower(size);
+        for (size_t s = 0; s < size; ++s) lower[s] = nodes[s].reduce(result[s / 2]);
+        result.swap(lower);
+    }
+
+    result.resize(tree.size());
+}
+
+void RemainderTree::remainders(const Integer &x, std::vector<uint32_t> &result) const {
+    std::vector<Integer> rests;
+    remainders(x, rests);
+
+    result.resize(rests.size());
+    for (size_t s = 0; s < rests.size(); ++s) result[s] = rests[s].toUnsignedInt();
+}
+
+}
@@ -0,0 +1,48 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <modinteger.h>
+#include <producttree.h>
+
+namespace ampc {
+
+/*
+RemainderTree reduces an Integer modulo many moduli at once: the value is reduced modulo the
+product of all moduli and the remainders are passed down the product tree, each node reducing
+the remainder of its parent. The reduction data of every node is precomputed, such that the
+descent does not need general divisions.
+*/
+class RemainderTree {
+public:
+    RemainderTree(const std::vector<Integer> &moduli);
+    RemainderTree(const std::vector<uint32_t> &moduli);
+
+    const ProductTree &getProductTree() const {return tree;}
+
+    void remainders(const Integer &x, std::vector<Integer> &result) const;
+    void remainders(const Integer &x, std::vector<uint32_t> &result) const;
+
+private:
+    ProductTree tree;
+    std::vector<std::vector<ModContext>> contexts;
+
+    void prepare();
+};
+
+}
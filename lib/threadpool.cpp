@@ -0,0 +1,102 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <threadpool.h>
+
+namespace ampc {
+
+ThreadPool &ThreadPool::getInstance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::setSize(const unsigned size) {
+    stop();
+
+    threads = size > 0 ? size : 1;
+    stopping = false;
+    for (unsigned i = 1; i < threads; ++i) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+void ThreadPool::run(std::vector<std::function<void()>> &tasks) {
+    if (threads == 1 || tasks.size() < 2) {
+        for (auto &task : tasks) task();
+        return;
+    }
+
+    size_t remaining = tasks.size();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (auto &task : tasks) {
+        queue.emplace_back([this, &task, &remaining]() {
+            task();
+            std::lock_guard<std::mutex> guard(mutex);
+            --remaining;
+            condition.notify_all();
+        });
+    }
+    condition.notify_all();
+
+    while (remaining > 0) {
+        if (queue.empty()) {
+            condition.wait(lock);
+            continue;
+        }
+
+        std::function<void()> task = std::move(queue.front());
+        queue.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    stop();
+}
+
+void ThreadPool::stop() {
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for (std::thread &worker : workers) worker.join();
+    workers.clear();
+}
+
+void ThreadPool::work() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        condition.wait(lock, [this]() {return stopping || !queue.empty();});
+        if (stopping) return;
+
+        std::function<void()> task = std::move(queue.front());
+        queue.pop_front();
+
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+}
@@ -0,0 +1,62 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ampc {
+
+/*
+ThreadPool is the singleton, which the library uses to run large computations in parallel. It
+has size() - 1 worker threads, the thread calling run() is the last one. A thread waiting in
+run() executes pending tasks itself, so tasks may call run() again without dead locks. By
+default the size is 1 and everything runs on the calling thread.
+*/
+class ThreadPool {
+public:
+    static ThreadPool &getInstance();
+
+    void setSize(const unsigned size);
+    unsigned size() const {return threads;}
+
+    void run(std::vector<std::function<void()>> &tasks);
+
+private:
+    unsigned threads;
+    bool stopping;
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> queue;
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    ThreadPool() : threads(1), stopping(false) {}
+
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool &operator=(const ThreadPool&) = delete;
+
+    void stop();
+    void work();
+};
+
+}
@@ -0,0 +1,124 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <chineseremaindertest.h>
+
+#include <chineseremainder.h>
+#include <primes.h>
+#include <threadpool.h>
+
+#include <QtTest>
+
+using namespace ampc;
+
+namespace {
+
+std::vector<uint32_t> primesFrom(uint32_t p, const size_t count) {
+    std::vector<uint32_t> primes;
+    while (primes.size() < count) {
+        if (Primes::getInstance().isPrime(p)) primes.push_back(p);
+        ++p;
+    }
+    return primes;
+}
+
+void residues(const Integer &x, const std::vector<uint32_t> &moduli, std::vector<uint32_t> &result) {
+    result.clear();
+    for (const uint32_t m : moduli) result.push_back(x % m);
+}
+
+}
+
+void ChineseRemainderTest::productTreeTest() {
+    ProductTree tree(std::vector<uint32_t>{2, 3, 5, 7, 11});
+    QVERIFY(tree.size() == 5);
+    QVERIFY(tree.height() == 4);
+    QVERIFY(tree.root() == Integer(2310));
+    QVERIFY(tree.level(1).size() == 3);
+    QVERIFY(tree.level(1)[2] == Integer(11));
+
+    QVERIFY(ProductTree(std::vector<uint32_t>{}).root() == Integer(1));
+    QVERIFY(ProductTree(std::vector<Integer>{Integer(-4)}).root() == Integer(-4));
+}
+
+void ChineseRemainderTest::combineTest() {
+    ChineseRemainder small(std::vector<uint32_t>{3, 5, 7});
+    QVERIFY(small.getModulus() == Integer(105));
+    QVERIFY(small.combine(std::vector<uint32_t>{2, 3, 2}) == Integer(23));
+    QVERIFY(small.combine(std::vector<uint32_t>{0, 0, 0}) == Integer(0));
+    QVERIFY(small.combine(std::vector<uint32_t>{2, 3}) == Integer(105));
+    QVERIFY(small.combine(std::vector<uint32_t>{2, 3, 2, 1}) == Integer(105));
+
+    ChineseRemainder single(std::vector<uint32_t>{4294967291u});
+    QVERIFY(single.combine(std::vector<uint32_t>{17}) == Integer(17));
+
+    const std::vector<uint32_t> moduli = primesFrom(4000000000u, 101);
+    ChineseRemainder crt(moduli);
+
+    Integer x(3);
+    x.power(Integer(1900));
+    x -= 12345;
+    QVERIFY(x < crt.getModulus());
+
+    std::vector<uint32_t> r;
+    residues(x, moduli, r);
+    QVERIFY(crt.combine(r) == x);
+
+    residues(crt.getModulus() - 1, moduli, r);
+    QVERIFY(crt.combine(r) == crt.getModulus() - 1);
+}
+
+void ChineseRemainderTest::batchTest() {
+    const std::vector<uint32_t> moduli = primesFrom(65000, 60);
+    ChineseRemainder crt(moduli);
+
+    std::vector<Integer> values;
+    std::vector<std::vector<uint32_t>> r(20);
+    for (uint32_t i = 0; i < 20; ++i) {
+        Integer x(7);
+        x.power(Integer(100 + 13 * i));
+        values.push_back(x % crt.getModulus());
+        residues(values.back(), moduli, r[i]);
+    }
+
+    std::vector<Integer> results;
+    ThreadPool::getInstance().setSize(3);
+    crt.combine(r, results);
+    ThreadPool::getInstance().setSize(1);
+
+    QVERIFY(results == values);
+
+    r[5].pop_back();
+    crt.combine(r, results);
+    QVERIFY(results[4] == values[4]);
+    QVERIFY(results[5] == crt.getModulus());
+}
+
+void ChineseRemainderTest::performanceCombineTest() {
+    const std::vector<uint32_t> moduli = primesFrom(3000000000u, 4096);
+    ChineseRemainder crt(moduli);
+
+    Integer x(3);
+    x.power(Integer(80000));
+
+    std::vector<uint32_t> r;
+    residues(x, moduli, r);
+
+    QBENCHMARK {
+        crt.combine(r);
+    }
+}
@@ -0,0 +1,134 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <discretelogtest.h>
+
+#include <discretelog.h>
+#include <randomgenerator.h>
+
+using namespace ampc;
+
+namespace {
+
+// 2^64 - 2^32 + 1, p - 1 = 2^32 * 3 * 5 * 17 * 257 * 65537
+const uint64_t Smooth = 18446744069414584321ull;
+
+// p - 1 = 20 q with the prime q = 2199023255579 > 2^40, which is solved by Pollard's rho
+const uint64_t LargeFactor = 43980465111581ull;
+
+Integer power(const uint64_t g, const uint64_t x, const uint64_t p) {
+    return Integer(g).powerModulo(Integer(x), Integer(p));
+}
+
+}
+
+void DiscreteLogarithmTest::smallTest() {
+    QVERIFY(DiscreteLogarithm::discreteLog(2u, 8u, 11u) == 3);
+    QVERIFY(DiscreteLogarithm::discreteLog(3u, 13u, 17u) == 4);
+    QVERIFY(DiscreteLogarithm::discreteLog(3u, 1u, 17u) == 0);
+    QVERIFY(DiscreteLogarithm::discreteLog(20u, 13u, 17u) == 4);
+    QVERIFY(DiscreteLogarithm::discreteLog(16u, 16u, 17u) == 1);
+    QVERIFY(DiscreteLogarithm::discreteLog(16u, 1u, 17u) == 0);
+    QVERIFY(DiscreteLogarithm::discreteLog(0u, 0u, 7u) == 1);
+    QVERIFY(DiscreteLogarithm::discreteLog(1u, 1u, 2u) == 0);
+
+    for (uint32_t g = 1; g < 23; ++g) {
+        uint32_t h = 1;
+        for (uint32_t x = 0; x < 22; ++x) {
+            const uint32_t y = DiscreteLogarithm::discreteLog(g, h, 23u);
+            QVERIFY(y <= x && power(g, y, 23) == Integer(h));
+            h = h * g % 23;
+        }
+    }
+}
+
+void DiscreteLogarithmTest::wordTest() {
+    RandomGenerator generator;
+    for (const uint32_t p : {65537u, 2013265921u, 3221225473u, 4294967291u}) {
+        for (uint32_t i = 0; i < 20; ++i) {
+            const uint32_t g = generator.below(p - 2) + 2, x = generator.below(p - 1);
+            const uint32_t h = power(g, x, p).toUnsignedLongInt();
+
+            const uint32_t y = DiscreteLogarithm::discreteLog(g, h, p);
+            QVERIFY(y <= x && power(g, y, p) == Integer(h));
+        }
+    }
+}
+
+void DiscreteLogarithmTest::longWordTest() {
+    RandomGenerator generator;
+    for (const uint64_t p : {Smooth, LargeFactor}) {
+        for (uint32_t i = 0; i < 5; ++i) {
+            const uint64_t g = generator.next() % (p - 2) + 2, x = generator.next() % (p - 1);
+            const uint64_t h = power(g, x, p).toUnsignedLongInt();
+
+            const uint64_t y = DiscreteLogarithm::discreteLog(g, h, p);
+            QVERIFY(y <= x && power(g, y, p) == Integer(h));
+        }
+    }
+}
+
+void DiscreteLogarithmTest::integerTest() {
+    QVERIFY(DiscreteLogarithm::discreteLog(Integer(3), Integer(-4), Integer(-17)) == Integer(4));
+    QVERIFY(DiscreteLogarithm::discreteLog(Integer(Smooth - 1), Integer(1), Integer(Smooth)) == Integer(0));
+    QVERIFY(DiscreteLogarithm::discreteLog(Integer(Smooth - 1), Integer(Smooth - 1), Integer(Smooth)) == Integer(1));
+
+    // p - 1 = 2 * 3^3 * 7^2 * 19 * 43 * 73 * 127 * 337 * 5419 * 92737 * 649657 * 77158673929
+    const Integer p = (Integer(1) << 127) - 1;
+
+    RandomGenerator generator;
+    for (uint32_t i = 0; i < 3; ++i) {
+        const Integer g = generator.below(p - 2) + 2, x = generator.below(p - 1);
+        Integer h = g;
+        h.powerModulo(x, p);
+
+        const Integer y = DiscreteLogarithm::discreteLog(g, h, p);
+        QVERIFY(y <= x && Integer(g).powerModulo(y, p) == h);
+    }
+}
+
+void DiscreteLogarithmTest::noSolutionTest() {
+    QVERIFY(DiscreteLogarithm::discreteLog(4u, 3u, 7u) == 7);
+    QVERIFY(DiscreteLogarithm::discreteLog(3u, 0u, 7u) == 7);
+    QVERIFY(DiscreteLogarithm::discreteLog(0u, 3u, 7u) == 7);
+    QVERIFY(DiscreteLogarithm::discreteLog(1u, 0u, 2u) == 2);
+    QVERIFY(DiscreteLogarithm::discreteLog(Smooth - 1, (uint64_t)3, Smooth) == Smooth);
+
+    // p = 2 q + 1 with a prime q > 2^64
+    const Integer p("2361183241434822609107");
+    QVERIFY(DiscreteLogarithm::discreteLog(Integer(4), Integer(5), p) == p);
+    QVERIFY(DiscreteLogarithm::discreteLog(p - 1, Integer(1), p) == Integer(0));
+    QVERIFY(DiscreteLogarithm::discreteLog(p - 1, p - 1, p) == Integer(1));
+}
+
+void DiscreteLogarithmTest::performanceBabyStepTest() {
+    RandomGenerator generator;
+    const uint64_t g = generator.next() % Smooth, h = generator.next() % Smooth;
+
+    QBENCHMARK {
+        DiscreteLogarithm::discreteLog(g, h, Smooth);
+    }
+}
+
+void DiscreteLogarithmTest::performancePollardRhoTest() {
+    RandomGenerator generator;
+    const uint64_t g = 2, h = power(g, generator.next() % LargeFactor, LargeFactor).toUnsignedLongInt();
+
+    QBENCHMARK {
+        DiscreteLogarithm::discreteLog(g, h, LargeFactor);
+    }
+}
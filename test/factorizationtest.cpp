@@ -0,0 +1,260 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <factorizationtest.h>
+
+#include <factorization.h>
+#include <randomgenerator.h>
+#include <threadpool.h>
+
+using namespace ampc;
+
+namespace {
+
+Integer randomPrime(RandomGenerator &generator, const uint32_t bits) {
+    Integer p;
+    do {
+        p = generator.bits(bits);
+    } while (!p.millerRabinPrimalityTest());
+    return p;
+}
+
+Integer product(const std::vector<std::pair<Integer, uint32_t>> &factors) {
+    Integer result(1);
+    for (const auto &factor : factors) {
+        for (uint32_t i = 0; i < factor.second; ++i) result *= factor.first;
+    }
+    return result;
+}
+
+}
+
+void FactorizationTest::factorTest() {
+    std::vector<std::pair<Integer, uint32_t>> factors;
+
+    Factorization::factor(Integer(0), factors);
+    QVERIFY(factors.empty());
+
+    Factorization::factor(Integer(1), factors);
+    QVERIFY(factors.empty());
+
+    Factorization::factor(Integer(-12), factors);
+    QVERIFY(factors.size() == 2);
+    QVERIFY(factors[0] == std::make_pair(Integer(2), 2u));
+    QVERIFY(factors[1] == std::make_pair(Integer(3), 1u));
+
+    Factorization::factor(Integer(1) << 64, factors);
+    QVERIFY(factors.size() == 1);
+    QVERIFY(factors[0] == std::make_pair(Integer(2), 64u));
+
+    Factorization::factor(Integer(65537) * 65537 * 65521, factors);
+    QVERIFY(factors.size() == 2);
+    QVERIFY(factors[0] == std::make_pair(Integer(65521), 1u));
+    QVERIFY(factors[1] == std::make_pair(Integer(65537), 2u));
+
+    Factorization::factor(Integer("600851475143"), factors);
+    QVERIFY(factors.size() == 4);
+    QVERIFY(factors[0].first == 71 && factors[1].first == 839 && factors[2].first == 1471 && factors[3].first == 6857);
+
+    Factorization::factor(Integer("147573952589676412927"), factors);
+    QVERIFY(factors.size() == 2);
+    QVERIFY(factors[0] == std::make_pair(Integer(193707721), 1u));
+    QVERIFY(factors[1] == std::make_pair(Integer("761838257287"), 1u));
+
+    Factorization::factor(Integer("170141183460469231731687303715884105727"), factors);
+    QVERIFY(factors.size() == 1);
+    QVERIFY(factors[0].second == 1);
+}
+
+void FactorizationTest::primePowerTest() {
+    std::vector<std::pair<Integer, uint32_t>> factors;
+
+    Integer p(4294967291u), n = p * p * p * 9;
+    Factorization::factor(n, factors);
+    QVERIFY(factors.size() == 2);
+    QVERIFY(factors[0] == std::make_pair(Integer(3), 2u));
+    QVERIFY(factors[1] == std::make_pair(p, 3u));
+
+    Integer q("1000000007"), r("2305843009213693951");
+    Factorization::factor(q * q * r * r, factors);
+    QVERIFY(factors.size() == 2);
+    QVERIFY(factors[0] == std::make_pair(q, 2u));
+    QVERIFY(factors[1] == std::make_pair(r, 2u));
+}
+
+void FactorizationTest::pollardRhoTest() {
+    const Integer n = Integer("4294967291") * Integer("4294967279");
+    const Integer d = Factorization::pollardRho(n);
+    QVERIFY(d > 1 && d < n);
+    QVERIFY(n % d == 0);
+
+    QVERIFY(Factorization::pollardRho(Integer(1) << 100) == 2);
+    QVERIFY(Factorization::pollardRho(Integer(0)) == 0);
+    QVERIFY(Factorization::pollardRho(Integer(1)) == 1);
+    QVERIFY(Factorization::pollardRho(Integer(3)) == 3);
+    QVERIFY(Factorization::pollardRho(Integer(4)) == 2);
+}
+
+void FactorizationTest::randomFactorTest() {
+    RandomGenerator generator(7);
+    std::vector<std::pair<Integer, uint32_t>> factors;
+
+    for (int i = 0; i < 10; ++i) {
+        std::vector<Integer> primes;
+        for (uint32_t j = 0; j < 4; ++j) primes.push_back(randomPrime(generator, 17 + generator.below(16u)));
+        std::sort(primes.begin(), primes.end());
+
+        Integer n = Integer::product(primes) * (i + 1);
+        Factorization::factor(n, factors);
+        QVERIFY(product(factors) == n);
+        for (const auto &factor : factors) QVERIFY(factor.first.millerRabinPrimalityTest());
+        for (const Integer &p : primes) {
+            QVERIFY(std::find_if(factors.begin(), factors.end(), [&p](const std::pair<Integer, uint32_t> &f) {return f.first == p;}) != factors.end());
+        }
+    }
+}
+
+void FactorizationTest::ecmTest() {
+    RandomGenerator generator(13);
+    const Integer p = randomPrime(generator, 50), q = randomPrime(generator, 90);
+
+    const Integer d = Factorization::ecm(p * q, 2000, 0, 200);
+    QVERIFY(d == p || d == q);
+
+    QVERIFY(Factorization::ecm(Integer(1) << 80, 100) == 2);
+    QVERIFY(Factorization::ecm(q, 500, 0, 5) == q);
+
+    const Integer n = Integer("1000000007") * Integer("998244353");
+    const Integer e = Factorization::ecm(n, 20, 2000, 50, 1);
+    QVERIFY(e > 1 && n % e == 0);
+
+    std::vector<std::pair<Integer, uint32_t>> factors;
+    Factorization::factor(p * q * 12, factors);
+    QVERIFY(factors.size() == 4);
+    QVERIFY(factors[2] == std::make_pair(p, 1u));
+    QVERIFY(factors[3] == std::make_pair(q, 1u));
+
+    // without ECM rho and the sieve cannot split a product of two 120 bit primes
+    QVERIFY(Factorization::ecmLevels() == 2);
+    const Integer r = randomPrime(generator, 120), s = randomPrime(generator, 120);
+    Factorization::setEcmLevels(0);
+    Factorization::factor(r * s * 3, factors);
+    Factorization::setEcmLevels(9);
+    QVERIFY(Factorization::ecmLevels() == 5);
+    Factorization::setEcmLevels(2);
+    QVERIFY(factors.size() == 2);
+    QVERIFY(factors[1] == std::make_pair(r * s, 1u));
+}
+
+void FactorizationTest::parallelEcmTest() {
+    RandomGenerator generator(17);
+    const Integer p = randomPrime(generator, 45), q = randomPrime(generator, 80);
+
+    ThreadPool::getInstance().setSize(4);
+    const Integer d = Factorization::ecm(p * q, 2000, 0, 200, 5);
+    ThreadPool::getInstance().setSize(1);
+
+    QVERIFY(d == p || d == q);
+}
+
+void FactorizationTest::quadraticSieveTest() {
+    RandomGenerator generator(19);
+
+    for (uint32_t bits = 40; bits <= 60; bits += 10) {
+        const Integer p = randomPrime(generator, bits), q = randomPrime(generator, bits + 5);
+        const Integer d = Factorization::quadraticSieve(p * q);
+        QVERIFY(d == p || d == q);
+    }
+
+    const Integer n = randomPrime(generator, 40) * randomPrime(generator, 45) * randomPrime(generator, 50);
+    const Integer d = Factorization::quadraticSieve(n);
+    QVERIFY(d > 1 && d < n && n % d == 0);
+
+    const Integer small = Factorization::quadraticSieve(Integer("1000000016000000063"));
+    QVERIFY(small == Integer("1000000007") || small == Integer("1000000009"));
+
+    const Integer large = randomPrime(generator, 110) * randomPrime(generator, 110);
+    QVERIFY(Factorization::quadraticSieve(large) == large);
+
+    std::vector<std::pair<Integer, uint32_t>> factors;
+    const Integer p = randomPrime(generator, 70), q = randomPrime(generator, 72);
+    Factorization::factor(p * q * 5, factors);
+    QVERIFY(factors.size() == 3);
+    QVERIFY(factors[1] == std::make_pair(p, 1u));
+    QVERIFY(factors[2] == std::make_pair(q, 1u));
+}
+
+void FactorizationTest::parallelQuadraticSieveTest() {
+    RandomGenerator generator(23);
+    const Integer p = randomPrime(generator, 55), q = randomPrime(generator, 60);
+
+    ThreadPool::getInstance().setSize(4);
+    const Integer d = Factorization::quadraticSieve(p * q, 3);
+    ThreadPool::getInstance().setSize(1);
+
+    QVERIFY(d == p || d == q);
+}
+
+void FactorizationTest::performancePollardRhoTest() {
+    RandomGenerator generator;
+    std::vector<Integer> composites;
+    for (int i = 0; i < 10; ++i) composites.push_back(randomPrime(generator, 32) * randomPrime(generator, 32));
+
+    std::vector<std::pair<Integer, uint32_t>> factors;
+    QBENCHMARK {
+        for (const Integer &n : composites) Factorization::factor(n, factors);
+    }
+}
+
+void FactorizationTest::performanceEcmTest_data() {
+    QTest::addColumn<unsigned>("digits");
+
+    for (unsigned digits = 10; digits <= 15; digits += 5) {
+        QTest::newRow(std::to_string(digits).c_str()) << digits;
+    }
+}
+
+void FactorizationTest::performanceEcmTest() {
+    QFETCH(unsigned, digits);
+
+    RandomGenerator generator(digits);
+    const Integer n = randomPrime(generator, digits * 10 / 3) * randomPrime(generator, 128);
+
+    QBENCHMARK {
+        Factorization::ecm(n, digits < 15 ? 2000 : 11000, 0, 1000);
+    }
+}
+
+void FactorizationTest::performanceQuadraticSieveTest_data() {
+    QTest::addColumn<unsigned>("digits");
+
+    for (unsigned digits = 30; digits <= 55; digits += 5) {
+        QTest::newRow(std::to_string(digits).c_str()) << digits;
+    }
+}
+
+void FactorizationTest::performanceQuadraticSieveTest() {
+    QFETCH(unsigned, digits);
+
+    RandomGenerator generator(digits);
+    const uint32_t bits = digits * 10 / 6;
+    const Integer n = randomPrime(generator, bits) * randomPrime(generator, bits + 1);
+
+    QBENCHMARK {
+        Factorization::quadraticSieve(n);
+    }
+}
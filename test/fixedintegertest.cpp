@@ -0,0 +1,135 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <fixedintegertest.h>
+
+#include <fixedinteger.h>
+
+#include <QtTest>
+
+using namespace ampc;
+
+namespace {
+
+template<size_t Limbs>
+constexpr bool printsAs(const FixedInteger<Limbs> &value, const char *expected) {
+    char buffer[Limbs * 10 + 2] = {};
+    value.print(buffer, sizeof(buffer));
+    for (size_t s = 0; ; ++s) {
+        if (buffer[s] != expected[s]) return false;
+        if (buffer[s] == '\0') return true;
+    }
+}
+
+constexpr FixedInteger<4> faculty(uint32_t i) {
+    FixedInteger<4> result(1u);
+    for (uint32_t j = 2; j <= i; ++j) result *= FixedInteger<4>(j);
+    return result;
+}
+
+constexpr FixedInteger<4> Modulus("340282366920938463463374607431768211297");
+
+}
+
+void FixedIntegerTest::compileTimeTest() {
+    static_assert(FixedInteger<2>("18446744073709551615") == FixedInteger<2>(std::numeric_limits<uint64_t>::max()), "parsing");
+    static_assert(FixedInteger<2>("-5") + FixedInteger<2>(3) == FixedInteger<2>(-2), "addition");
+    static_assert(FixedInteger<4>(Basis) * FixedInteger<4>(Basis) == FixedInteger<4>("18446744073709551616"), "multiplication");
+    static_assert(faculty(30) == FixedInteger<4>("265252859812191058636308480000000"), "faculty");
+    static_assert(faculty(30) / faculty(28) == FixedInteger<4>(870), "division");
+    static_assert((faculty(30) + FixedInteger<4>(7)) % faculty(10) == FixedInteger<4>(7), "modulo");
+    static_assert(Modulus.size() == 4, "size");
+    static_assert(printsAs(Modulus - FixedInteger<4>(1u), "340282366920938463463374607431768211296"), "printing");
+    static_assert(printsAs(FixedInteger<1>(-1), "-1"), "printing negatives");
+
+    constexpr FixedInteger<4> remainder = faculty(34) % Modulus;
+    QVERIFY(remainder.toInteger() == Integer::faculty(34) % Modulus.toInteger());
+}
+
+void FixedIntegerTest::generationTest() {
+    FixedInteger<3> a("-123456789012345678901234567");
+    QVERIFY(a.toInteger() == Integer("-123456789012345678901234567"));
+
+    std::string str;
+    a.print(str);
+    QVERIFY(str == "-123456789012345678901234567");
+
+    FixedInteger<3> b("0");
+    b.print(str);
+    QVERIFY(str == "0");
+    QVERIFY(b.isZero());
+    QVERIFY(FixedInteger<3>("-0") == b);
+
+    QVERIFY(FixedInteger<2>((int64_t)-Basis).toInteger() == Integer(-(int64_t)Basis));
+}
+
+void FixedIntegerTest::arithmeticTest() {
+    const FixedInteger<6> a("99999999999999999999999999"), b("-1000000000000000000000");
+
+    QVERIFY((a + b).toInteger() == a.toInteger() + b.toInteger());
+    QVERIFY((a - b).toInteger() == a.toInteger() - b.toInteger());
+    QVERIFY((b - a).toInteger() == b.toInteger() - a.toInteger());
+    QVERIFY((a * b).toInteger() == a.toInteger() * b.toInteger());
+
+    QVERIFY(b < a);
+    QVERIFY(-a < b);
+    QVERIFY(a - a == FixedInteger<6>(0));
+}
+
+void FixedIntegerTest::divisionTest() {
+    QVERIFY(FixedInteger<2>(11) / FixedInteger<2>(-5) == FixedInteger<2>(-2));
+    QVERIFY(FixedInteger<2>(-11) % FixedInteger<2>(5) == FixedInteger<2>(4));
+    QVERIFY(FixedInteger<2>(-11) % FixedInteger<2>(-5) == FixedInteger<2>(4));
+    QVERIFY(FixedInteger<2>(-10) % FixedInteger<2>(5) == FixedInteger<2>(0));
+
+    const FixedInteger<6> a("100000000000000000000000000009000000000000000125");
+    const FixedInteger<6> b("100000000000000000000000000000");
+    auto result = a.divideWithRest(b);
+    QVERIFY(result.first == FixedInteger<6>("1000000000000000000"));
+    QVERIFY(result.second == FixedInteger<6>("9000000000000000125"));
+}
+
+void FixedIntegerTest::overflowTest() {
+    bool thrown = false;
+    try {
+        FixedInteger<1> a(Basis);
+    }
+    catch (const std::overflow_error &) {
+        thrown = true;
+    }
+    QVERIFY(thrown);
+
+    thrown = false;
+    try {
+        FixedInteger<2> a(Basis);
+        a *= a;
+    }
+    catch (const std::overflow_error &) {
+        thrown = true;
+    }
+    QVERIFY(thrown);
+
+    thrown = false;
+    try {
+        FixedInteger<2> a(1);
+        a /= FixedInteger<2>(0);
+    }
+    catch (const std::domain_error &) {
+        thrown = true;
+    }
+    QVERIFY(thrown);
+}
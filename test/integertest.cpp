@@ -18,9 +18,16 @@ along with ampclib; if not, see http://www.gnu.org/licenses.
 #include <integertest.h>
 
 #include <integer.h>
+#include <factorization.h>
+#include <primes.h>
+#include <randomgenerator.h>
+#include <threadpool.h>
 
 #include <QtTest>
 
+#include <algorithm>
+#include <thread>
+
 using namespace ampc;
 
 void IntegerTest::generationTest() {
@@ -107,6 +114,60 @@ void IntegerTest::multiplicationTest() {
             * Integer("-1000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"));
 }
 
+void IntegerTest::largeMultiplicationTest() {
+    Integer a(Basis), b(3), c(7);
+    a.power(Integer(1000));
+    b.power(Integer(20000));
+    c.power(Integer(7000));
+
+    QVERIFY((a + 1) * (a - 1) == a * a - 1);
+    QVERIFY((b + c) * (b - c) == b * b - c * c);
+    QVERIFY(b * c == c * b);
+    QVERIFY((b * c) / c == b);
+    QVERIFY((b * c) % b == Integer(0));
+
+    Integer d = b;
+    QVERIFY(d.power(Integer(3)) == b * b * b);
+}
+
+void IntegerTest::parallelMultiplicationTest() {
+    Integer a(3), b(7), c(11);
+    a.power(Integer(300000));
+    b.power(Integer(200000));
+    c.power(Integer(30000));
+
+    Integer serialSquare = a * a, serialProduct = a * b, serialUnbalanced = a * c;
+
+    ThreadPool::getInstance().setSize(4);
+    QVERIFY(a * a == serialSquare);
+    QVERIFY(a * b == serialProduct);
+    QVERIFY(a * c == serialUnbalanced);
+    ThreadPool::getInstance().setSize(1);
+}
+
+void IntegerTest::productTest() {
+    QVERIFY(Integer::product(std::vector<Integer>()) == 1);
+    QVERIFY(Integer::product(std::vector<uint32_t>()) == 1);
+    QVERIFY(Integer::product(std::vector<Integer>{Integer(-3), Integer(5)}) == -15);
+
+    std::vector<uint32_t> words;
+    std::vector<Integer> factors;
+    Integer folded(1);
+    for (uint32_t i = 1; i <= 3000; ++i) {
+        words.push_back(MaxLimit - i);
+        factors.push_back(Integer(MaxLimit - i) * i - 1);
+        folded *= factors.back();
+    }
+    QVERIFY(Integer::product(factors) == folded);
+    QVERIFY(Integer::product(std::vector<uint32_t>(words.begin(), words.begin() + 10)) == Integer::product(std::vector<Integer>(words.begin(), words.begin() + 10)));
+
+    const Integer serial = Integer::product(words);
+    ThreadPool::getInstance().setSize(4);
+    QVERIFY(Integer::product(words) == serial);
+    QVERIFY(Integer::product(factors) == folded);
+    ThreadPool::getInstance().setSize(1);
+}
+
 void IntegerTest::divisionTest() {
     QVERIFY(Integer("2") == Integer("11") / Integer("5"));
     QVERIFY(Integer("-2") == Integer("11") / Integer("-5"));
@@ -121,11 +182,31 @@ void IntegerTest::divisionTest() {
     QVERIFY(Integer(Basis * 9) / Integer(18) == Integer(Basis * 9 / 18));
 }
 
+void IntegerTest::divisionPropertyTest() {
+    RandomGenerator generator(29);
+
+    for (int i = 0; i < 300; ++i) {
+        Integer a = generator.bits(1 + generator.below(3000u)), b = generator.bits(1 + generator.below(2000u));
+        if (generator.below(2u) == 1) a = -a;
+        if (generator.below(2u) == 1) b = -b;
+
+        const std::pair<Integer, Integer> result = a.divideWithRest(b);
+        const Integer &rest = result.second;
+        QVERIFY(rest.isPositive() && (rest < b || rest < -b));
+        QVERIFY((a - rest) / b * b == a - rest);
+        if (a.isPositive()) QVERIFY(result.first * b + rest == a);
+        QVERIFY(a % b == rest);
+        QVERIFY((a + b) * (a - b) == a * a - b * b);
+    }
+}
+
 void IntegerTest::moduloTest() {
     QVERIFY(Integer("1") == Integer("11") % Integer("5"));
     QVERIFY(Integer("1") == Integer("11") % Integer("-5"));
     QVERIFY(Integer("4") == Integer("-11") % Integer("5"));
     QVERIFY(Integer("4") == Integer("-11") % Integer("-5"));
+    QVERIFY(Integer("0") == Integer("-10") % Integer("5"));
+    QVERIFY(Integer("99999999999999999999999999999") == Integer("-1") % Integer("100000000000000000000000000000"));
 
     QVERIFY(Integer("100000000000000000000000000009000000000000000125") % Integer("100000000000000000000000000000") == Integer("9000000000000000125"));
     QVERIFY(Integer("100000000000000000000000000000000000000000000125") % Integer("100000000000000000000000000000") == Integer("125"));
@@ -209,9 +290,43 @@ void IntegerTest::functionTest() {
     QVERIFY(Integer::lucas(2).toInt() == 3);
     QVERIFY(Integer::lucas(10).toInt() == 123);
 
+    QVERIFY(Integer::fibonacci(100) == Integer("354224848179261915075"));
+    QVERIFY(Integer::lucas(100) == Integer("792070839848372253127"));
+    QVERIFY(Integer::fibonacciPair(0) == std::make_pair(Integer(0), Integer(1)));
+    QVERIFY(Integer::fibonacciPair(99) == std::make_pair(Integer("218922995834555169026"), Integer("354224848179261915075")));
+    QVERIFY(Integer::lucasPair(0) == std::make_pair(Integer(2), Integer(0)));
+    QVERIFY(Integer::lucasPair(100) == std::make_pair(Integer::lucas(100), Integer::fibonacci(100)));
+
+    Integer f(0), g(1);
+    for (uint32_t i = 0; i < 300; ++i) {
+        QVERIFY(Integer::fibonacci(i) == f);
+        QVERIFY(Integer::lucas(i) == g * 2 - f);
+        g += f;
+        f = g - f;
+    }
+
     QVERIFY(Integer::faculty(0).toInt() == 0);
     QVERIFY(Integer::faculty(1).toInt() == 1);
     QVERIFY(Integer::faculty(4).toInt() == 24);
+    QVERIFY(Integer::faculty(20) == Integer("2432902008176640000"));
+
+    Integer faculty(1), doubleFaculty(1), primorial(1);
+    std::vector<Integer> doubleFaculties = {Integer(1), Integer(1)};
+    for (uint32_t i = 1; i < 300; ++i) {
+        faculty *= i;
+        if (i >= 2) doubleFaculties.push_back(doubleFaculties[i - 2] * i);
+        if (Primes::getInstance().isPrime(i)) primorial *= i;
+        QVERIFY(Integer::faculty(i) == faculty);
+        QVERIFY(Integer::doubleFaculty(i) == doubleFaculties[i]);
+        QVERIFY(Integer::primorial(i) == primorial);
+    }
+    QVERIFY(Integer::doubleFaculty(0) == 1);
+    QVERIFY(Integer::doubleFaculty(9) == 945);
+    QVERIFY(Integer::doubleFaculty(10) == 3840);
+    QVERIFY(Integer::primorial(0) == 1);
+    QVERIFY(Integer::primorial(30) == Integer((uint64_t)6469693230));
+    QVERIFY(Integer::faculty(70001) == Integer::faculty(69999) * 70000 * 70001);
+    QVERIFY(Integer::doubleFaculty(70001) == Integer::doubleFaculty(69999) * 70001);
 
     QVERIFY(Integer::binomial(3,0).toInt() == 1);
     QVERIFY(Integer::binomial(3,3).toInt() == 1);
@@ -219,6 +334,17 @@ void IntegerTest::functionTest() {
     QVERIFY(Integer::binomial(7,3).toInt() == 35);
     QVERIFY(Integer::binomial(8,6).toInt() == 28);
 
+    std::vector<Integer> row = {Integer(1)};
+    for (uint32_t n = 1; n < 80; ++n) {
+        std::vector<Integer> next(n + 1, Integer(1));
+        for (uint32_t k = 1; k < n; ++k) next[k] = row[k - 1] + row[k];
+        row = next;
+        for (uint32_t k = 0; k <= n; ++k) QVERIFY(Integer::binomial(n, k) == row[k]);
+    }
+    QVERIFY(Integer::binomial(1000, 16) * 16 == Integer::binomial(1000, 15) * 985);
+    QVERIFY(Integer::binomial(4000000000u, 3) == Integer((uint64_t)4000000000) * 3999999999u * 3999999998u / 6);
+    QVERIFY(Integer::binomial(100000, 50000) == Integer::faculty(100000) / (Integer::faculty(50000) * Integer::faculty(50000)));
+
     QVERIFY(Integer::multiSet(0, 0) == 1);
     QVERIFY(Integer::multiSet(3, 0) == 1);
     QVERIFY(Integer::multiSet(0, 5) == 0);
@@ -246,6 +372,19 @@ void IntegerTest::functionTest() {
     QVERIFY(Integer::lcm(Integer(100), Integer(12)) == Integer(300));
 }
 
+void IntegerTest::shiftTest() {
+    QVERIFY((Integer(1) << 100) == Integer(2).power(Integer(100)));
+    QVERIFY((Integer(-3) << 33) == Integer(-3) * Integer(Basis * 2));
+    QVERIFY((Integer("123456789123456789123456789") >> 0) == Integer("123456789123456789123456789"));
+    QVERIFY((Integer("123456789123456789123456789") >> 40) == Integer("123456789123456789123456789") / Integer(Basis * 256));
+    QVERIFY((Integer(Basis) >> 64) == Integer(0));
+
+    QVERIFY(Integer(0).bitLength() == 0);
+    QVERIFY(Integer(1).bitLength() == 1);
+    QVERIFY(Integer(Basis).bitLength() == 33);
+    QVERIFY(Integer(-255).bitLength() == 8);
+}
+
 void IntegerTest::powerTest() {
     Integer a(3), p(-2);
 
@@ -271,6 +410,68 @@ void IntegerTest::powerTest() {
     QVERIFY(Integer("100000000000000000000").power(3) == Integer(10).power(60));
 }
 
+void IntegerTest::rootTest() {
+    QVERIFY(Integer(0).isqrt() == Integer(0));
+    QVERIFY(Integer(1).isqrt() == Integer(1));
+    QVERIFY(Integer(3).isqrt() == Integer(1));
+    QVERIFY(Integer(4).isqrt() == Integer(2));
+    QVERIFY(Integer(-4).isqrt() == Integer(-4));
+    QVERIFY(Integer(std::numeric_limits<uint64_t>::max()).isqrt() == Integer(MaxLimit));
+
+    for (uint32_t i = 0; i < 2000; ++i) {
+        Integer x = Integer(Basis).power(Integer(7)) * (i + 1) + Integer(i * i);
+        Integer r = x;
+        r.isqrt();
+        QVERIFY(r * r <= x);
+        QVERIFY((r + 1) * (r + 1) > x);
+    }
+
+    Integer ten(10);
+    ten.power(Integer(1001));
+    QVERIFY((ten * ten).isqrt() == ten);
+    QVERIFY((ten * ten - 1).isqrt() == ten - 1);
+
+    QVERIFY(Integer(26).iroot(3) == Integer(2));
+    QVERIFY(Integer(27).iroot(3) == Integer(3));
+    QVERIFY(Integer(-27).iroot(3) == Integer(-3));
+    QVERIFY(Integer(-26).iroot(3) == Integer(-2));
+    QVERIFY(Integer(-28).iroot(3) == Integer(-3));
+    QVERIFY(Integer(1000).iroot(1) == Integer(1000));
+
+    for (uint32_t n = 2; n < 120; n += 7) {
+        Integer x = ten + Integer(n);
+        Integer r = x;
+        r.iroot(n);
+        Integer lower = r, upper = r + 1;
+        QVERIFY(lower.power(Integer(n)) <= x);
+        QVERIFY(upper.power(Integer(n)) > x);
+    }
+}
+
+void IntegerTest::perfectPowerTest() {
+    QVERIFY(Integer(0).isPerfectSquare());
+    QVERIFY(Integer(1).isPerfectSquare());
+    QVERIFY(!Integer(2).isPerfectSquare());
+    QVERIFY(!Integer(-4).isPerfectSquare());
+    QVERIFY(Integer("152415787532388367501905199875019052100").isPerfectSquare());
+    QVERIFY(!Integer("152415787532388367501905199875019052101").isPerfectSquare());
+
+    for (uint32_t i = 0; i < 3000; ++i) {
+        Integer x(i);
+        Integer r = x;
+        r.isqrt();
+        QVERIFY(x.isPerfectSquare() == (r * r == x));
+    }
+
+    QVERIFY(Integer(8).isPerfectPower());
+    QVERIFY(Integer(-8).isPerfectPower());
+    QVERIFY(!Integer(-4).isPerfectPower());
+    QVERIFY(!Integer(12).isPerfectPower());
+    QVERIFY(Integer(7).power(Integer(31)).isPerfectPower());
+    QVERIFY(!(Integer(7).power(Integer(31)) + 1).isPerfectPower());
+    QVERIFY(!(Integer(6).power(Integer(40)) * 7).isPerfectPower());
+}
+
 void IntegerTest::powerModuloTest() {
     QVERIFY(Integer(2).powerModulo(Integer(3), Integer(3)) == Integer(2));
     QVERIFY(Integer(4).powerModulo(Integer(2), Integer(7)) == Integer(2));
@@ -287,6 +488,168 @@ void IntegerTest::powerModuloTest() {
     QVERIFY(Integer(10).powerModulo(Integer("23"), Integer("6643838879")) == Integer(5559987813));
     QVERIFY(Integer(10).powerModulo(Integer(97), Integer(6643838879)) == Integer(5668857816));
     QVERIFY(Integer(10).powerModulo(Integer("6643838878"), Integer("6643838879")) == Integer(1));
+
+    QVERIFY(Integer::multiPowerModulo({Integer(10), Integer(10)}, {Integer(23), Integer(74)}, Integer(6643838879)) == Integer(5668857816));
+    QVERIFY(Integer::multiPowerModulo({Integer(3), Integer(5)}, {Integer(4), Integer(2)}, Integer(1000)) == Integer(25));
+    QVERIFY(Integer::multiPowerModulo({}, {}, Integer(7)) == Integer(1));
+    QVERIFY(Integer::multiPowerModulo({Integer(3), Integer(5)}, {Integer(4)}, Integer(1000)) == Integer(81));
+}
+
+void IntegerTest::sqrtModuloTest() {
+    QVERIFY(Integer(2).sqrtModulo(Integer(7)) == Integer(3));
+    QVERIFY(Integer(-5).sqrtModulo(Integer(7)) == Integer(3));
+    QVERIFY(Integer(3).sqrtModulo(Integer(7)) == Integer(7));
+    QVERIFY(Integer("1000000000000").sqrtModulo(Integer(-4294967291)) == Integer(1000000));
+
+    const Integer composite = ((Integer(1) << 64) + 13) * ((Integer(1) << 64) - 59);
+    QVERIFY(Integer(4).sqrtModulo(composite) == composite);
+
+    // 7 * 2^120 + 1 and 45 * 2^200 + 1 are handled by Cipolla, the others by Tonelli-Shanks
+    const std::vector<Integer> primes = {
+        Integer("170141183460469231731687303715884105727"),
+        Integer("57896044618658097711785492504343953926634992332820282019728792003956564819949"),
+        Integer("9304595970494411110326649421962412033"),
+        Integer("72312211991654562399388294155352317113499134720225677588561921")
+    };
+
+    RandomGenerator generator;
+    for (const Integer &p : primes) {
+        QVERIFY(Integer(p).sqrtModulo(p).isZero());
+
+        uint32_t nonResidues = 0;
+        for (uint32_t i = 0; i < 20; ++i) {
+            const Integer x = generator.below(p);
+            const Integer a = x * x % p;
+
+            Integer r = a;
+            r.sqrtModulo(p);
+            QVERIFY(r == x || r == p - x);
+            QVERIFY(r * 2 < p);
+
+            Integer s = generator.below(p);
+            const Integer b = s;
+            s.sqrtModulo(p);
+            if (s == p) ++nonResidues;
+            else QVERIFY(s * s % p == b);
+        }
+        QVERIFY(nonResidues > 0);
+    }
+}
+
+void IntegerTest::orderTest() {
+    QVERIFY(Integer::order(Integer(5), Integer(0)) == Integer(0));
+    QVERIFY(Integer::order(Integer(-5), Integer(-7)) == Integer(3));
+
+    const Integer m89 = (Integer(1) << 89) - 1, m61 = (Integer(1) << 61) - 1;
+    QVERIFY(Integer::order(Integer(2), m89) == Integer(89));
+    QVERIFY(Integer::order(Integer(2), m89 * m61) == Integer(89 * 61));
+    QVERIFY(Integer::order(Integer(3), Integer(1) << 200) == Integer(1) << 198);
+    QVERIFY(Integer::order(m61, m89 * m61).isZero());
+    QVERIFY(Integer::order(Integer(43), (Integer(1) << 127) - 1) == (Integer(1) << 127) - 2);
+    QVERIFY(Integer::order(Integer(-1), (Integer(1) << 127) - 1) == Integer(2));
+}
+
+void IntegerTest::primitiveRootTest() {
+    QVERIFY(Integer::primitiveRoot(Integer(-23)) == Integer(5));
+    QVERIFY(Integer::primitiveRoot(Integer("18446744069414584321")) == Integer(7));
+    QVERIFY(Integer::primitiveRoot((Integer(1) << 127) - 1) == Integer(43));
+    QVERIFY(Integer::primitiveRoot((Integer(1) << 127) + 1).isZero());
+
+    // without ECM r s stays a composite factor of p - 1
+    RandomGenerator generator(3);
+    Integer r = generator.bits(120), s = generator.bits(120);
+    r.nextPrime();
+    s.nextPrime();
+    Integer p = r * s * 2 + 1;
+    while (!p.millerRabinPrimalityTest()) p += r * s * 2;
+
+    Factorization::setEcmLevels(0);
+    const Integer root = Integer::primitiveRoot(p), order = Integer::order(Integer(2), p), composite = Integer::order(Integer(2), r * s);
+    Factorization::setEcmLevels(2);
+    QVERIFY(root.isZero());
+    QVERIFY(order.isZero());
+    QVERIFY(composite.isZero());
+}
+
+void IntegerTest::kroneckerTest() {
+    QVERIFY(Integer::kroneckerSymbol(Integer(-1), Integer(0)) == 1);
+    QVERIFY(Integer::kroneckerSymbol(Integer(3), Integer(0)) == 0);
+    QVERIFY(Integer::kroneckerSymbol(Integer(-1), Integer(-1)) == -1);
+    QVERIFY(Integer::kroneckerSymbol(Integer(1), Integer(-1)) == 1);
+    QVERIFY(Integer::kroneckerSymbol(Integer(-1), Integer(7)) == -1);
+    QVERIFY(Integer::kroneckerSymbol(Integer(-5), Integer(-12)) == -1);
+    QVERIFY(Integer::kroneckerSymbol(Integer(6), Integer(-12)) == 0);
+
+    RandomGenerator generator;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        const uint64_t a = generator.next(), b = generator.next() >> (i % 64);
+        QVERIFY(Integer::kroneckerSymbol(Integer(a), Integer(b)) == Primes::kroneckerSymbol(a, b));
+    }
+
+    // Euler's criterion for primes
+    const Integer m127 = (Integer(1) << 127) - 1;
+    for (const Integer &p : {m127, Integer("57896044618658097711785492504343953926634992332820282019728792003956564819949")}) {
+        for (uint32_t i = 0; i < 20; ++i) {
+            const Integer a = generator.below(p);
+            Integer euler = a;
+            euler.powerModulo(p >> 1, p);
+            QVERIFY(Integer::kroneckerSymbol(a, p) == (euler == Integer(1) ? 1 : -1));
+        }
+    }
+
+    // (2 / n) depends on n mod 8, (a / m127^2) = 1 for all units
+    QVERIFY(Integer::kroneckerSymbol(Integer(2), m127) == 1);
+    QVERIFY(Integer::kroneckerSymbol(generator.below(m127) + 1, m127 * m127) == 1);
+    QVERIFY(Integer::kroneckerSymbol(m127 * 3, m127 * 5) == 0);
+}
+
+namespace {
+
+void moduli(const uint32_t count, const uint32_t digits, std::vector<Integer> &result) {
+    Integer base(10);
+    base.power(Integer(digits));
+
+    std::vector<Integer> factors;
+    for (uint32_t i = 0; i < count + 2; ++i) factors.push_back(base + Integer(2 * i * i + 29));
+
+    result.clear();
+    for (uint32_t i = 0; i < count; ++i) result.push_back(factors[i] * factors[(7 * i + 3) % (count + 2)]);
+}
+
+}
+
+void IntegerTest::batchGcdTest() {
+    std::vector<Integer> values;
+    moduli(40, 12, values);
+    values.push_back(values[5]);
+    values.push_back(Integer(-91));
+
+    std::vector<Integer> gcds;
+    Integer::batchGcd(values, gcds);
+    QVERIFY(gcds.size() == values.size());
+
+    for (size_t s = 0; s < values.size(); ++s) {
+        Integer others(1);
+        for (size_t t = 0; t < values.size(); ++t) {
+            if (t != s) others *= values[t];
+        }
+        QVERIFY(gcds[s] == Integer::gcd(values[s], others));
+    }
+
+    ThreadPool::getInstance().setSize(4);
+    std::vector<Integer> parallelGcds;
+    Integer::batchGcd(values, parallelGcds);
+    ThreadPool::getInstance().setSize(1);
+    QVERIFY(parallelGcds == gcds);
+
+    Integer::batchGcd(std::vector<Integer>{Integer(15)}, gcds);
+    QVERIFY(gcds == std::vector<Integer>{Integer(1)});
+
+    Integer::batchGcd(std::vector<Integer>{Integer(6), Integer(0), Integer(-35)}, gcds);
+    QVERIFY(gcds == (std::vector<Integer>{Integer(6), Integer(210), Integer(35)}));
+
+    Integer::batchGcd(std::vector<Integer>{Integer(0), Integer(10), Integer(0)}, gcds);
+    QVERIFY(gcds == (std::vector<Integer>{Integer(0), Integer(10), Integer(0)}));
 }
 
 void IntegerTest::millerRabinTest() {
@@ -299,6 +662,74 @@ void IntegerTest::millerRabinTest() {
     QVERIFY(!Integer("9999999999999999").millerRabinPrimalityTest());
     QVERIFY(!Integer("10000000000000000").millerRabinPrimalityTest());
     QVERIFY(!Integer("555555555555555555").millerRabinPrimalityTest());
+
+    QVERIFY(Integer("2305843009213693951").millerRabinPrimalityTest());
+    QVERIFY(Integer("618970019642690137449562111").millerRabinPrimalityTest());
+    QVERIFY(Integer("170141183460469231731687303715884105727").millerRabinPrimalityTest());
+    QVERIFY(Integer("-2305843009213693951").millerRabinPrimalityTest());
+    QVERIFY(!Integer("147573952589676412927").millerRabinPrimalityTest());
+    QVERIFY(!Integer("3825123056546413051").millerRabinPrimalityTest());
+    QVERIFY(!Integer("318665857834031151167461").millerRabinPrimalityTest());
+    QVERIFY(!(Integer("2305843009213693951") * Integer("618970019642690137449562111")).millerRabinPrimalityTest());
+}
+
+void IntegerTest::lucasLehmerTest() {
+    const std::vector<uint32_t> exponents = {2, 3, 5, 7, 13, 17, 19, 31, 61, 89, 107, 127, 521, 607};
+    for (uint32_t p = 0; p < 700; ++p) {
+        QVERIFY(Integer::lucasLehmerTest(p) == std::binary_search(exponents.begin(), exponents.end(), p));
+    }
+    QVERIFY(Integer::lucasLehmerTest(1279));
+    QVERIFY(!Integer::lucasLehmerTest(1277));
+}
+
+void IntegerTest::nextPrimeTest() {
+    QVERIFY(Integer(-7).nextPrime() == Integer(2));
+    QVERIFY(Integer(0).nextPrime() == Integer(2));
+    QVERIFY(Integer(2).nextPrime() == Integer(3));
+    QVERIFY(Integer(3).nextPrime() == Integer(5));
+    QVERIFY(Integer(90).nextPrime() == Integer(97));
+    QVERIFY(Integer((uint64_t)4294967291).nextPrime() == Integer((uint64_t)4294967311));
+    QVERIFY(Integer("4294967296").nextPrime() == Integer((uint64_t)4294967311));
+    QVERIFY(Integer("18446744073709551616").nextPrime() == Integer("18446744073709551629"));
+    QVERIFY(Integer("170141183460469231731687303715884105726").nextPrime() == Integer("170141183460469231731687303715884105727"));
+
+    Integer googol(10);
+    googol.power(100);
+    QVERIFY(Integer(googol).nextPrime() == googol + 267);
+
+    RandomGenerator generator;
+    for (uint32_t i = 0; i < 20; ++i) {
+        const Integer a = generator.bits(100 + 10 * i);
+        Integer p = a;
+        p.nextPrime();
+        QVERIFY(p > a && p.millerRabinPrimalityTest());
+        QVERIFY(Integer(p).prevPrime() <= a);
+    }
+}
+
+void IntegerTest::prevPrimeTest() {
+    QVERIFY(Integer(-7).prevPrime() == Integer(-7));
+    QVERIFY(Integer(2).prevPrime() == Integer(2));
+    QVERIFY(Integer(3).prevPrime() == Integer(2));
+    QVERIFY(Integer(4).prevPrime() == Integer(3));
+    QVERIFY(Integer(100).prevPrime() == Integer(97));
+    QVERIFY(Integer((uint64_t)4294967311).prevPrime() == Integer((uint64_t)4294967291));
+    QVERIFY(Integer("4294967296").prevPrime() == Integer((uint64_t)4294967291));
+    QVERIFY(Integer("18446744073709551616").prevPrime() == Integer("18446744073709551557"));
+    QVERIFY(Integer("170141183460469231731687303715884105728").prevPrime() == Integer("170141183460469231731687303715884105727"));
+
+    Integer googol(10);
+    googol.power(100);
+    QVERIFY(Integer(googol).prevPrime() == googol - 797);
+
+    RandomGenerator generator;
+    for (uint32_t i = 0; i < 20; ++i) {
+        const Integer a = generator.bits(100 + 10 * i);
+        Integer p = a;
+        p.prevPrime();
+        QVERIFY(p < a && p.millerRabinPrimalityTest());
+        QVERIFY(Integer(p).nextPrime() >= a);
+    }
 }
 
 void IntegerTest::performanceAdditionTest() {
@@ -322,14 +753,134 @@ void IntegerTest::performanceMultiplicationTest() {
     }
 }
 
+void IntegerTest::performanceLargeMultiplicationTest_data() {
+    QTest::addColumn<unsigned>("threads");
+
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        QTest::newRow(std::to_string(threads).c_str()) << threads;
+    }
+    QTest::newRow(std::to_string(maxThreads).c_str()) << maxThreads;
+}
+
+void IntegerTest::performanceLargeMultiplicationTest() {
+    QFETCH(unsigned, threads);
+
+    RandomGenerator generator;
+    const Integer a = generator.bits(3200000), b = generator.bits(3100000);
+    Integer c;
+
+    ThreadPool::getInstance().setSize(threads);
+    QBENCHMARK {
+        c = a * b;
+    }
+    ThreadPool::getInstance().setSize(1);
+}
+
+void IntegerTest::performanceProductTest() {
+    std::vector<uint32_t> factors;
+    for (uint32_t i = 0; i < 100000; ++i) factors.push_back(MaxLimit - 2 * i);
+
+    QBENCHMARK {
+        Integer::product(factors);
+    }
+}
+
+void IntegerTest::performanceSquareRootTest() {
+    RandomGenerator generator;
+    const Integer a = generator.bits(32000);
+
+    QBENCHMARK {
+        Integer r = a;
+        r.isqrt();
+    }
+}
+
+void IntegerTest::performanceBatchGcdTest() {
+    std::vector<Integer> values, gcds;
+    moduli(256, 40, values);
+
+    QBENCHMARK {
+        Integer::batchGcd(values, gcds);
+    }
+}
+
 void IntegerTest::performanceFibonacciTest() {
     QBENCHMARK {
-        Integer::fibonacci(100000);
+        Integer::fibonacci(10000000);
+    }
+}
+
+void IntegerTest::performanceLucasTest() {
+    QBENCHMARK {
+        Integer::lucasPair(10000000);
+    }
+}
+
+void IntegerTest::performanceSqrtModuloTest() {
+    RandomGenerator generator;
+    const Integer p = (Integer(1) << 521) - 1;
+    const Integer x = generator.below(p);
+    const Integer a = x * x % p;
+
+    QBENCHMARK {
+        Integer(a).sqrtModulo(p);
+    }
+}
+
+void IntegerTest::performancePrimitiveRootTest() {
+    // 2^64 - 2^32 + 1, the prime of many number theoretic transforms
+    const Integer p("18446744069414584321");
+
+    QBENCHMARK {
+        Integer::primitiveRoot(p);
+    }
+}
+
+void IntegerTest::performanceLucasLehmerTest() {
+    QBENCHMARK {
+        Integer::lucasLehmerTest(4423);
+    }
+}
+
+void IntegerTest::performanceNextPrimeTest_data() {
+    QTest::addColumn<unsigned>("bits");
+
+    for (unsigned bits = 256; bits <= 1024; bits *= 2) {
+        QTest::newRow(std::to_string(bits).c_str()) << bits;
+    }
+}
+
+void IntegerTest::performanceNextPrimeTest() {
+    QFETCH(unsigned, bits);
+
+    RandomGenerator generator;
+    const Integer a = generator.bits(bits);
+
+    QBENCHMARK {
+        Integer p = a;
+        p.nextPrime();
+    }
+}
+
+void IntegerTest::performanceBinomialTest_data() {
+    QTest::addColumn<unsigned>("a");
+
+    for (unsigned a = 100000; a <= 10000000; a *= 10) {
+        QTest::newRow(std::to_string(a).c_str()) << a;
+    }
+}
+
+void IntegerTest::performanceBinomialTest() {
+    QFETCH(unsigned, a);
+
+    QBENCHMARK {
+        Integer::binomial(a, a / 3);
     }
 }
 
 void IntegerTest::performanceFacultyTest() {
     QBENCHMARK {
-        Integer::faculty(10000);
+        Integer::faculty(1000000);
     }
 }
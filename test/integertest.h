@@ -26,20 +26,49 @@ private slots:
     void additionTest();
     void subtractionTest();
     void multiplicationTest();
+    void largeMultiplicationTest();
+    void parallelMultiplicationTest();
+    void productTest();
     void divisionTest();
+    void divisionPropertyTest();
     void moduloTest();
     void incrementTest();
     void decrementTest();
     void unsignedIntTest();
     void functionTest();
+    void shiftTest();
     void powerTest();
+    void rootTest();
+    void perfectPowerTest();
     void powerModuloTest();
+    void sqrtModuloTest();
+    void orderTest();
+    void primitiveRootTest();
+    void kroneckerTest();
+    void batchGcdTest();
     void millerRabinTest();
+    void lucasLehmerTest();
+    void nextPrimeTest();
+    void prevPrimeTest();
 
     void performanceAdditionTest();
     void performanceSubtractionTest();
     void performanceMultiplicationTest();
+    void performanceLargeMultiplicationTest_data();
+    void performanceLargeMultiplicationTest();
+    void performanceProductTest();
+
+    void performanceSquareRootTest();
+    void performanceBatchGcdTest();
+    void performanceSqrtModuloTest();
+    void performancePrimitiveRootTest();
+    void performanceLucasLehmerTest();
+    void performanceNextPrimeTest_data();
+    void performanceNextPrimeTest();
 
     void performanceFibonacciTest();
+    void performanceLucasTest();
     void performanceFacultyTest();
+    void performanceBinomialTest_data();
+    void performanceBinomialTest();
 };
@@ -0,0 +1,170 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <integervectortest.h>
+
+#include <integervector.h>
+
+#include <QtTest>
+
+using namespace ampc;
+
+namespace {
+
+constexpr size_t Size = 37;
+constexpr size_t Width = 4;
+constexpr size_t BenchmarkSize = 1000000;
+
+Integer value(uint64_t &state, const size_t width) {
+    Integer result;
+    for (size_t s = 0; s < width; ++s) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint32_t limb = (uint32_t)(state >> 32);
+        if (state % 7 == 0) limb = (uint32_t)MaxLimit;
+        result = result * Integer(Basis) + Integer(limb);
+    }
+    return result;
+}
+
+void fill(IntegerVector &vector, std::vector<Integer> &integers, uint64_t seed) {
+    integers.clear();
+    for (size_t s = 0; s < vector.size(); ++s) {
+        integers.push_back(value(seed, vector.width()));
+        vector.set(s, integers.back());
+    }
+}
+
+Integer modulus() {
+    Integer m(Basis);
+    return m.power(Integer((uint32_t)Width));
+}
+
+}
+
+void IntegerVectorTest::generationTest() {
+    IntegerVector vector(3, 2);
+    vector.set(0, Integer("18446744073709551615"));
+    vector.set(1, Integer(7));
+    vector.set(2, Integer("-340282366920938463463374607431768211457"));
+
+    QVERIFY(vector.get(0) == Integer("18446744073709551615"));
+    QVERIFY(vector.get(1) == Integer(7));
+    QVERIFY(vector.get(2) == Integer(1));
+}
+
+void IntegerVectorTest::additionTest() {
+    IntegerVector a(Size, Width), b(Size, Width);
+    std::vector<Integer> x, y;
+    fill(a, x, 1);
+    fill(b, y, 2);
+
+    std::vector<uint32_t> carries;
+    a.add(b, carries);
+
+    for (size_t s = 0; s < Size; ++s) {
+        QVERIFY(a.get(s) + Integer(carries[s]) * modulus() == x[s] + y[s]);
+    }
+}
+
+void IntegerVectorTest::subtractionTest() {
+    IntegerVector a(Size, Width), b(Size, Width);
+    std::vector<Integer> x, y;
+    fill(a, x, 3);
+    fill(b, y, 4);
+
+    std::vector<uint32_t> borrows;
+    a.subtract(b, borrows);
+
+    for (size_t s = 0; s < Size; ++s) {
+        QVERIFY(a.get(s) - Integer(borrows[s]) * modulus() == x[s] - y[s]);
+    }
+}
+
+void IntegerVectorTest::multiplicationTest() {
+    IntegerVector a(Size, Width);
+    std::vector<Integer> x;
+    fill(a, x, 5);
+
+    std::vector<uint32_t> overflows;
+    a.multiply(4000000007u, overflows);
+
+    for (size_t s = 0; s < Size; ++s) {
+        QVERIFY(a.get(s) + Integer(overflows[s]) * modulus() == x[s] * 4000000007u);
+    }
+}
+
+void IntegerVectorTest::comparisionTest() {
+    IntegerVector a(Size, Width), b(Size, Width);
+    std::vector<Integer> x, y;
+    fill(a, x, 6);
+    fill(b, y, 7);
+    for (size_t s = 0; s < Size; s += 3) {
+        b.set(s, x[s]);
+        y[s] = x[s];
+    }
+
+    std::vector<int32_t> result;
+    a.compare(b, result);
+
+    for (size_t s = 0; s < Size; ++s) {
+        QVERIFY(result[s] == (x[s] == y[s] ? 0 : x[s] > y[s] ? 1 : -1));
+    }
+}
+
+void IntegerVectorTest::performanceVectorAdditionTest() {
+    IntegerVector a(BenchmarkSize, Width), b(BenchmarkSize, Width);
+    std::vector<Integer> x, y;
+    fill(a, x, 8);
+    fill(b, y, 9);
+
+    std::vector<uint32_t> carries;
+    QBENCHMARK {
+        a.add(b, carries);
+    }
+}
+
+void IntegerVectorTest::performanceIntegerAdditionTest() {
+    IntegerVector a(BenchmarkSize, Width), b(BenchmarkSize, Width);
+    std::vector<Integer> x, y;
+    fill(a, x, 8);
+    fill(b, y, 9);
+
+    QBENCHMARK {
+        for (size_t s = 0; s < BenchmarkSize; ++s) x[s] = x[s] + y[s];
+    }
+}
+
+void IntegerVectorTest::performanceVectorMultiplicationTest() {
+    IntegerVector a(BenchmarkSize, Width);
+    std::vector<Integer> x;
+    fill(a, x, 10);
+
+    std::vector<uint32_t> overflows;
+    QBENCHMARK {
+        a.multiply(3u, overflows);
+    }
+}
+
+void IntegerVectorTest::performanceIntegerMultiplicationTest() {
+    IntegerVector a(BenchmarkSize, Width);
+    std::vector<Integer> x;
+    fill(a, x, 10);
+
+    QBENCHMARK {
+        for (size_t s = 0; s < BenchmarkSize; ++s) x[s] = x[s] * 3u;
+    }
+}
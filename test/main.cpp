@@ -16,6 +16,14 @@ along with ampclib; if not, see http://www.gnu.org/licenses.
 */
 
 #include "integertest.h"
+#include "fixedintegertest.h"
+#include "integervectortest.h"
+#include "modintegertest.h"
+#include "chineseremaindertest.h"
+#include "remaindertreetest.h"
+#include "randomgeneratortest.h"
+#include "factorizationtest.h"
+#include "discretelogtest.h"
 #include "primetest.h"
 #include "rationaltest.h"
 
@@ -29,11 +37,51 @@ int main(int argc, char **argv)
        status |= QTest::qExec(&t, argc, argv);
    }
 
+   {
+       FixedIntegerTest t;
+       status |= QTest::qExec(&t, argc, argv);
+   }
+
+   {
+       IntegerVectorTest t;
+       status |= QTest::qExec(&t, argc, argv);
+   }
+
+   {
+       ModIntegerTest t;
+       status |= QTest::qExec(&t, argc, argv);
+   }
+
+   {
+       RandomGeneratorTest t;
+       status |= QTest::qExec(&t, argc, argv);
+   }
+
    {
        RationalTest t;
        status |= QTest::qExec(&t, argc, argv);
    }
 
+   {
+       ChineseRemainderTest t;
+       status |= QTest::qExec(&t, argc, argv);
+   }
+
+   {
+       RemainderTreeTest t;
+       status |= QTest::qExec(&t, argc, argv);
+   }
+
+   {
+       FactorizationTest t;
+       status |= QTest::qExec(&t, argc, argv);
+   }
+
+   {
+       DiscreteLogarithmTest t;
+       status |= QTest::qExec(&t, argc, argv);
+   }
+
    {
       PrimeTest tc;
       status |= QTest::qExec(&tc, argc, argv);
@@ -0,0 +1,244 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <modintegertest.h>
+
+#include <modinteger.h>
+#include <randomgenerator.h>
+
+#include <QtTest>
+
+using namespace ampc;
+
+namespace {
+
+const Integer Odd("340282366920938463463374607431768211507");
+const Integer Even("100000000000000000000000000000000000000000000000000000000000");
+const Integer Special("57896044618658097711785492504343953926634992332820282019728792003956564819949");
+
+}
+
+void ModIntegerTest::contextTest() {
+    QVERIFY(ModContext(Odd).usesMontgomery());
+    QVERIFY(!ModContext(Even).usesMontgomery());
+    QVERIFY(ModContext(Special).usesSpecialForm());
+    QVERIFY(!ModContext(Special).usesMontgomery());
+    QVERIFY(!ModContext(Odd).usesSpecialForm());
+
+    ModContext context(Integer(-7));
+    QVERIFY(context.getModulus() == Integer(7));
+    QVERIFY(context.reduce(Integer(-11)) == Integer(3));
+    QVERIFY(context.reduce(Integer(-14)) == Integer(0));
+    QVERIFY(context.reduce(Integer("1000000000000000000000000000000")) == Integer("1000000000000000000000000000000") % 7);
+
+    ModContext even(Even);
+    Integer x("123456789012345678901234567890123456789012345678901234567890123456789");
+    QVERIFY(even.reduce(x) == x % Even);
+    QVERIFY(even.reduce(x * x) == (x * x) % Even);
+
+    ModContext one(Integer(1));
+    QVERIFY(ModInteger(one, Integer(5)).toInteger() == Integer(0));
+}
+
+void ModIntegerTest::additionTest() {
+    for (const Integer &n : {Odd, Even, Special}) {
+        ModContext context(n);
+        Integer a("123456789012345678901234567890123456789"), b("-987654321098765432109876543210");
+
+        ModInteger x(context, a), y(context, b);
+        QVERIFY((x + y).toInteger() == (a + b) % n);
+        QVERIFY((x - y).toInteger() == (a - b) % n);
+        QVERIFY((y - x).toInteger() == (b - a) % n);
+        QVERIFY((-x).toInteger() == (-a) % n);
+        QVERIFY((x - x).isZero());
+    }
+}
+
+void ModIntegerTest::multiplicationTest() {
+    for (const Integer &n : {Odd, Even, Special}) {
+        ModContext context(n);
+        Integer a("123456789012345678901234567890123456789"), b("-987654321098765432109876543210");
+
+        ModInteger x(context, a), y(context, b);
+        QVERIFY((x * y).toInteger() == (a * b) % n);
+        QVERIFY(ModInteger(x).square().toInteger() == (a * a) % n);
+
+        ModInteger z(context, Integer(1));
+        Integer c(1);
+        for (uint32_t i = 0; i < 100; ++i) {
+            z *= x;
+            c = c * a % n;
+        }
+        QVERIFY(z.toInteger() == c);
+    }
+}
+
+void ModIntegerTest::inversionTest() {
+    ModContext context(Odd);
+    ModInteger x(context, Integer("123456789012345678901234567890"));
+    ModInteger y = x;
+    QVERIFY((x * y.invert()).toInteger() == Integer(1));
+
+    ModContext even(Even);
+    QVERIFY(ModInteger(even, Integer(3)).invert().toInteger() * 3 % Even == Integer(1));
+    QVERIFY(ModInteger(even, Integer(5)).invert().isZero());
+}
+
+void ModIntegerTest::powerTest() {
+    ModContext context(Integer(6643838879));
+    QVERIFY(ModInteger(context, Integer(10)).power(Integer(97)).toInteger() == Integer(5668857816));
+    QVERIFY(ModInteger(context, Integer(10)).power(Integer("6643838878")).toInteger() == Integer(1));
+    QVERIFY(ModInteger(context, Integer(10)).power(Integer(0)).toInteger() == Integer(1));
+
+    ModInteger x(context, Integer(10));
+    QVERIFY((ModInteger(x).power(Integer(-5)) * ModInteger(x).power(Integer(5))).toInteger() == Integer(1));
+
+    for (const Integer &n : {Odd, Even, Special}) {
+        ModContext c(n);
+        Integer a("98765432109876543210987654321"), p(1);
+        for (uint32_t e = 0; e < 40; ++e) {
+            QVERIFY(ModInteger(c, a).power(Integer(e)).toInteger() == p);
+            p = p * a % n;
+        }
+    }
+}
+
+void ModIntegerTest::specialFormTest() {
+    const Integer mersenne = (Integer(1) << 521) - 1;
+    ModContext context(mersenne);
+    QVERIFY(context.usesSpecialForm());
+
+    RandomGenerator generator;
+    for (uint32_t i = 0; i < 50; ++i) {
+        const Integer a = generator.bits(521 + i), b = generator.below(mersenne);
+        QVERIFY(context.reduce(a) == a % mersenne);
+        QVERIFY(context.reduce(-a) == (-a) % mersenne);
+        QVERIFY((ModInteger(context, a) * ModInteger(context, b)).toInteger() == a * b % mersenne);
+    }
+    QVERIFY(context.reduce(mersenne) == Integer(0));
+    QVERIFY(context.reduce(mersenne - 1) == mersenne - 1);
+
+    for (const uint32_t c : {1u, 19u, 4294967295u}) {
+        const Integer n = (Integer(1) << 96) - c;
+        ModContext special(n);
+        QVERIFY(special.usesSpecialForm());
+
+        const Integer a = generator.below(n), e = generator.bits(96);
+        Integer expected = a;
+        expected.powerModulo(e, n * 3);
+        QVERIFY(ModInteger(special, a).power(e).toInteger() == expected % n);
+        QVERIFY(ModInteger(special, n - 1).square().toInteger() == Integer(1));
+    }
+}
+
+void ModIntegerTest::multiPowerTest() {
+    RandomGenerator generator;
+    for (const Integer &n : {Odd, Even, Special}) {
+        ModContext context(n);
+
+        std::vector<ModInteger> bases;
+        std::vector<Integer> exponents;
+        ModInteger expected(context, Integer(1));
+        for (uint32_t i = 0; i < 5; ++i) {
+            bases.push_back(ModInteger(context, generator.below(n)));
+            exponents.push_back(generator.bits(20 + 50 * i));
+            expected *= ModInteger(bases.back()).power(exponents.back());
+
+            QVERIFY(ModInteger::multiPower(context, bases, exponents) == expected);
+        }
+    }
+
+    ModContext context(Integer(6643838879));
+    const ModInteger ten(context, Integer(10));
+    QVERIFY(ModInteger::multiPower(context, {ten, ten}, {Integer(-5), Integer(5)}).toInteger() == Integer(1));
+    QVERIFY(ModInteger::multiPower(context, {ten, ten}, {Integer(0), Integer(0)}).toInteger() == Integer(1));
+    QVERIFY(ModInteger::multiPower(context, {}, {}).toInteger() == Integer(1));
+    QVERIFY(ModInteger::multiPower(context, {ten, ten}, {Integer(3)}).toInteger() == Integer(1000));
+    QVERIFY(ModInteger::multiPower(context, {ten}, {Integer(2), Integer(5)}).toInteger() == Integer(100));
+}
+
+void ModIntegerTest::fixedBaseTest() {
+    RandomGenerator generator;
+    for (const Integer &n : {Odd, Even, Special}) {
+        ModContext context(n);
+        const ModInteger g(context, generator.below(n));
+        const FixedBase fixed(g, 130);
+
+        for (uint32_t bits = 0; bits < 200; bits += 7) {
+            const Integer e = generator.bits(bits);
+            QVERIFY(fixed.power(e) == ModInteger(g).power(e));
+        }
+    }
+
+    ModContext context(Integer(6643838879));
+    const FixedBase ten(ModInteger(context, Integer(10)), 64);
+    QVERIFY(ten.power(Integer(97)).toInteger() == Integer(5668857816));
+    QVERIFY(ten.power(Integer("6643838878")).toInteger() == Integer(1));
+    QVERIFY((ten.power(Integer(-5)) * ten.power(Integer(5))).toInteger() == Integer(1));
+}
+
+void ModIntegerTest::performancePowerTest() {
+    RandomGenerator generator;
+    const Integer n = generator.bits(2048) * 2 + 1;
+    const Integer e = generator.below(n);
+
+    ModContext context(n);
+    ModInteger x(context, generator.below(n));
+
+    QBENCHMARK {
+        ModInteger(x).power(e);
+    }
+}
+
+void ModIntegerTest::performanceSpecialFormPowerTest() {
+    RandomGenerator generator;
+    const Integer n = (Integer(1) << 2203) - 1;
+    const Integer e = generator.below(n);
+
+    ModContext context(n);
+    ModInteger x(context, generator.below(n));
+
+    QBENCHMARK {
+        ModInteger(x).power(e);
+    }
+}
+
+void ModIntegerTest::performanceMultiPowerTest() {
+    RandomGenerator generator;
+    const Integer n = generator.bits(2048) * 2 + 1;
+
+    ModContext context(n);
+    const std::vector<ModInteger> bases = {ModInteger(context, generator.below(n)), ModInteger(context, generator.below(n))};
+    const std::vector<Integer> exponents = {generator.below(n), generator.below(n)};
+
+    QBENCHMARK {
+        ModInteger::multiPower(context, bases, exponents);
+    }
+}
+
+void ModIntegerTest::performanceFixedBaseTest() {
+    RandomGenerator generator;
+    const Integer n = generator.bits(2048) * 2 + 1;
+    const Integer e = generator.below(n);
+
+    ModContext context(n);
+    const FixedBase fixed(ModInteger(context, generator.below(n)), 2049);
+
+    QBENCHMARK {
+        fixed.power(e);
+    }
+}
@@ -18,7 +18,9 @@ along with ampclib; if not, see http://www.gnu.org/licenses.
 #include <primetest.h>
 
 #include <primes.h>
+#include <randomgenerator.h>
 
+#include <algorithm>
 #include <set>
 
 using namespace ampc;
@@ -29,6 +31,25 @@ void PrimeTest::isPrimeTest() {
     QVERIFY(Primes::getInstance().isPrime(2));
     QVERIFY(!Primes::getInstance().isPrime(1000));
     QVERIFY(Primes::getInstance().isPrime(1073676287));
+    QVERIFY(Primes::getInstance().isPrime(65537));
+
+    QVERIFY(!Primes::getInstance().isPrime(2047));
+    QVERIFY(!Primes::getInstance().isPrime(65535));
+    QVERIFY(Primes::getInstance().isPrime(65521));
+    QVERIFY(!Primes::getInstance().isPrime(1373653));
+    QVERIFY(!Primes::getInstance().isPrime(25326001));
+    QVERIFY(!Primes::getInstance().isPrime(3215031751));
+    QVERIFY(!Primes::getInstance().isPrime(4293001441));
+    QVERIFY(!Primes::getInstance().isPrime(4294967295));
+    QVERIFY(Primes::getInstance().isPrime(4294967291));
+
+    std::vector<uint32_t> primes;
+    Primes::getPrimes(1 << 21, primes);
+    for (uint32_t i = 0, j = 0; i < (1 << 21); ++i) {
+        const bool prime = j < primes.size() && primes[j] == i;
+        if (prime) ++j;
+        QVERIFY(Primes::getInstance().isPrime(i) == prime);
+    }
 }
 
 void PrimeTest::primeFactorTest() {
@@ -40,6 +61,34 @@ void PrimeTest::primeFactorTest() {
     QVERIFY(Primes::getInstance().getPrimeFactor(305175781) == 305175781);
 }
 
+void PrimeTest::getPrimesTest() {
+    std::vector<unsigned int> primes;
+
+    Primes::getPrimes(1, primes);
+    QVERIFY(primes.size() == 0);
+
+    Primes::getPrimes(100, primes);
+    QVERIFY(primes.size() == 25);
+    QVERIFY(primes.back() == 97);
+
+    Primes::getPrimes(65535, primes);
+    QVERIFY(primes.size() == 6542);
+
+    Primes::getPrimes(1000000, primes);
+    QVERIFY(primes.size() == 78498);
+    QVERIFY(primes.back() == 999983);
+    for (size_t i = 0; i < 6542; ++i) QVERIFY(Primes::getInstance().isPrime(primes[i]));
+
+    Primes::getPrimes(65537, primes);
+    QVERIFY(primes.size() == 6543);
+    QVERIFY(primes.back() == 65537);
+
+    Primes::getPrimes(1 << 24, primes);
+    QVERIFY(primes.size() == 1077871);
+    QVERIFY(primes.back() == 16777213);
+    for (size_t i = 1; i < primes.size(); i += 997) QVERIFY(Primes::getInstance().isPrime(primes[i]));
+}
+
 void PrimeTest::getPrimeFactorsTest() {
     std::vector<unsigned int> factors;
 
@@ -190,4 +239,147 @@ void PrimeTest::jacobiTest() {
     QVERIFY(Primes::jacobiSymbol(4, 7) == 1);
     QVERIFY(Primes::jacobiSymbol(5, 7) == -1);
     QVERIFY(Primes::jacobiSymbol(6, 7) == -1);
+
+    QVERIFY(Primes::jacobiSymbol(1001, 9907) == -1);
+    QVERIFY(Primes::jacobiSymbol(19, 45) == 1);
+    QVERIFY(Primes::jacobiSymbol(8, 21) == -1);
+    QVERIFY(Primes::jacobiSymbol(5, 21) == 1);
+    QVERIFY(Primes::jacobiSymbol(4294967290u, 4294967291u) == -1);
+
+    for (uint32_t b = 0; b < 200; ++b) {
+        std::vector<uint32_t> primeFactors;
+        Primes::getPrimeFactorsWithMultiplicity(b, primeFactors);
+        for (uint32_t a = 0; a < 200; ++a) {
+            int32_t expected = 1;
+            for (const uint32_t p : primeFactors) expected *= Primes::legendreSymbol(a, p);
+            QVERIFY(Primes::jacobiSymbol(a, b) == expected);
+        }
+    }
+}
+
+void PrimeTest::kroneckerTest() {
+    QVERIFY(Primes::kroneckerSymbol(1, 0) == 1);
+    QVERIFY(Primes::kroneckerSymbol(2, 0) == 0);
+    QVERIFY(Primes::kroneckerSymbol(0, 1) == 1);
+    QVERIFY(Primes::kroneckerSymbol(4, 6) == 0);
+    QVERIFY(Primes::kroneckerSymbol(3, 2) == -1);
+    QVERIFY(Primes::kroneckerSymbol(7, 2) == 1);
+    QVERIFY(Primes::kroneckerSymbol(5, 12) == -1);
+    QVERIFY(Primes::kroneckerSymbol(7, 12) == 1);
+    QVERIFY(Primes::kroneckerSymbol(1001, 9907) == -1);
+
+    // 2^64 - 59 is prime, so (a / p) = a^((p - 1) / 2)
+    const uint64_t p = 18446744073709551557ull;
+    QVERIFY(Primes::kroneckerSymbol(2, p) == -1);
+    QVERIFY(Primes::kroneckerSymbol(3, p) == -1);
+    QVERIFY(Primes::kroneckerSymbol(p - 1, p) == 1);
+    QVERIFY(Primes::kroneckerSymbol(p, p) == 0);
+
+    for (uint64_t b = 1; b < 300; b += 2) {
+        for (uint64_t a = 0; a < 300; ++a) {
+            QVERIFY(Primes::kroneckerSymbol(a, b) == Primes::jacobiSymbol(a, b));
+            QVERIFY(Primes::kroneckerSymbol(a, 2 * b) == Primes::kroneckerSymbol(a, 2) * Primes::kroneckerSymbol(a, b));
+        }
+    }
+}
+
+void PrimeTest::sqrtModuloTest() {
+    QVERIFY(Primes::sqrtModulo(0, 2) == 0);
+    QVERIFY(Primes::sqrtModulo(1, 2) == 1);
+    QVERIFY(Primes::sqrtModulo(2, 7) == 3);
+    QVERIFY(Primes::sqrtModulo(3, 7) == 7);
+    QVERIFY(Primes::sqrtModulo(14, 7) == 0);
+    QVERIFY(Primes::sqrtModulo(4, 15) == 15);
+    QVERIFY(Primes::sqrtModulo(4, 1) == 1);
+
+    // 2^16 + 1 and 9 * 2^17 + 1 have many factors 2 in p - 1 for Tonelli-Shanks, 7 * 2^26 + 1 and
+    // 3 * 2^30 + 1 with s (s - 1) > 276 are handled by Cipolla
+    for (const uint32_t p : {3u, 13u, 17u, 65537u, 1000003u, 1179649u, 469762049u, 3221225473u, 4294967291u}) {
+        uint32_t residues = 0;
+        for (uint64_t a = 1; a < 1000; ++a) {
+            const uint64_t r = Primes::sqrtModulo((uint32_t)(a * a * 7919 % p), p);
+            if (r < p) {
+                QVERIFY(r * r % p == a * a * 7919 % p);
+                QVERIFY(2 * r <= p);
+                ++residues;
+            }
+
+            const uint64_t s = Primes::sqrtModulo((uint32_t)(a * a % p), p);
+            QVERIFY(s == std::min(a % p, p - a % p));
+        }
+        QVERIFY(residues == 0 || residues == 999 || p < 1000);
+    }
+}
+
+void PrimeTest::orderTest() {
+    QVERIFY(Primes::order(5, 0) == 0);
+    QVERIFY(Primes::order(5, 1) == 1);
+    QVERIFY(Primes::order(2, 7) == 3);
+    QVERIFY(Primes::order(10, 7) == 6);
+    QVERIFY(Primes::order(17, 7) == 6);
+    QVERIFY(Primes::order(2, 15) == 4);
+    QVERIFY(Primes::order(3, 15) == 0);
+    QVERIFY(Primes::order(3, 1024) == 256);
+    QVERIFY(Primes::order(2, 4294967291u) == 4294967290u);
+
+    for (uint32_t n = 2; n < 200; ++n) {
+        for (uint32_t a = 0; a < n; ++a) {
+            uint32_t expected = 0, power = a;
+            for (uint32_t k = 1; k <= n && expected == 0; ++k) {
+                if (power == 1) expected = k;
+                power = power * a % n;
+            }
+            QVERIFY(Primes::order(a, n) == expected);
+        }
+    }
+}
+
+void PrimeTest::primitiveRootTest() {
+    QVERIFY(Primes::primitiveRoot(0) == 0);
+    QVERIFY(Primes::primitiveRoot(9) == 0);
+    QVERIFY(Primes::primitiveRoot(2) == 1);
+    QVERIFY(Primes::primitiveRoot(7) == 3);
+    QVERIFY(Primes::primitiveRoot(23) == 5);
+    QVERIFY(Primes::primitiveRoot(41) == 6);
+    QVERIFY(Primes::primitiveRoot(65537) == 3);
+    QVERIFY(Primes::primitiveRoot(998244353) == 3);
+    QVERIFY(Primes::primitiveRoot(3221225473u) == 5);
+    QVERIFY(Primes::primitiveRoot(4294967291u) == 2);
+
+    for (uint32_t p = 3; p < 2000; p += 2) {
+        if (Primes::getInstance().isPrime(p)) QVERIFY(Primes::order(Primes::primitiveRoot(p), p) == p - 1);
+    }
+}
+
+void PrimeTest::performanceKroneckerTest() {
+    RandomGenerator generator;
+    std::vector<uint64_t> values;
+    for (uint32_t i = 0; i < 20000; ++i) values.push_back(generator.next());
+
+    QBENCHMARK {
+        int32_t sum = 0;
+        for (size_t i = 0; i + 1 < values.size(); ++i) sum += Primes::kroneckerSymbol(values[i], values[i + 1] | 1);
+        QVERIFY(sum != 20000);
+    }
+}
+
+void PrimeTest::performanceSieveTest() {
+    std::vector<uint32_t> primes;
+
+    QBENCHMARK {
+        Primes::getPrimes(65537, primes);
+    }
+    QVERIFY(primes.size() == 6543);
+}
+
+void PrimeTest::performanceIsPrimeTest() {
+    RandomGenerator generator;
+    std::vector<uint32_t> values;
+    for (uint32_t i = 0; i < 100000; ++i) values.push_back((uint32_t)generator.next() | 1);
+
+    QBENCHMARK {
+        uint32_t count = 0;
+        for (const uint32_t value : values) count += Primes::getInstance().isPrime(value);
+        QVERIFY(count < values.size());
+    }
 }
@@ -25,6 +25,7 @@ class PrimeTest: public QObject
 private slots:
     void isPrimeTest();
     void primeFactorTest();
+    void getPrimesTest();
     void getPrimeFactorsTest();
     void getPrimeFactorsMultiplicityTest();
     void getFactorNumberTest();
@@ -37,4 +38,12 @@ private slots:
     void lambdaTest();
     void legendreTest();
     void jacobiTest();
+    void kroneckerTest();
+    void sqrtModuloTest();
+    void orderTest();
+    void primitiveRootTest();
+
+    void performanceKroneckerTest();
+    void performanceSieveTest();
+    void performanceIsPrimeTest();
 };
@@ -0,0 +1,93 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <randomgeneratortest.h>
+
+#include <randomgenerator.h>
+
+using namespace ampc;
+
+void RandomGeneratorTest::seedTest() {
+    RandomGenerator a(17), b(17), c(18);
+
+    bool different = false;
+    for (int i = 0; i < 100; ++i) {
+        const uint64_t x = a.next();
+        QVERIFY(x == b.next());
+        different |= x != c.next();
+    }
+    QVERIFY(different);
+
+    a.seed(5);
+    b.seed(5);
+    QVERIFY(a.bits(1000) == b.bits(1000));
+}
+
+void RandomGeneratorTest::wordTest() {
+    RandomGenerator generator;
+
+    QVERIFY(generator.below(0u) == 0);
+    QVERIFY(generator.below(1u) == 0);
+
+    std::vector<uint32_t> counts(6, 0);
+    for (int i = 0; i < 60000; ++i) ++counts[generator.below(6u)];
+    for (const uint32_t count : counts) QVERIFY(count > 9000 && count < 11000);
+
+    for (int i = 0; i < 1000; ++i) QVERIFY(generator.below(3000000001u) < 3000000001u);
+}
+
+void RandomGeneratorTest::belowTest() {
+    RandomGenerator generator(3);
+
+    QVERIFY(generator.below(Integer(0)) == 0);
+    QVERIFY(generator.below(Integer(-5)) == 0);
+    QVERIFY(generator.below(Integer(1)) == 0);
+
+    std::vector<uint32_t> counts(5, 0);
+    for (int i = 0; i < 50000; ++i) ++counts[generator.below(Integer(5)).toInt()];
+    for (const uint32_t count : counts) QVERIFY(count > 9000 && count < 11000);
+
+    Integer bound = (Integer(1) << 200) + 1;
+    bool large = false;
+    for (int i = 0; i < 1000; ++i) {
+        const Integer x = generator.below(bound);
+        QVERIFY(x.isPositive() && x < bound);
+        large |= x.bitLength() == 200;
+    }
+    QVERIFY(large);
+}
+
+void RandomGeneratorTest::bitsTest() {
+    RandomGenerator generator(11);
+
+    QVERIFY(generator.bits(0) == 0);
+    QVERIFY(generator.bits(1) == 1);
+
+    for (uint32_t length = 1; length < 300; ++length) {
+        const Integer x = generator.bits(length);
+        QVERIFY(x.isPositive());
+        QVERIFY(x.bitLength() == length);
+    }
+}
+
+void RandomGeneratorTest::performanceBitsTest() {
+    RandomGenerator generator;
+
+    QBENCHMARK {
+        generator.bits(10000000);
+    }
+}
@@ -0,0 +1,125 @@
+/*
+Copyright (C) 2018 Jan Christian Rohde
+
+This file is part of ampclib.
+
+ampclib is free software; you can redistribute it and/or modify it under the terms of the
+GNU General Public License as published by the Free Software Foundation; either version 3
+of the License, or (at your option) any later version.
+
+ampclib is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with ampclib; if not, see http://www.gnu.org/licenses.
+*/
+
+#include <remaindertreetest.h>
+
+#include <primes.h>
+#include <remaindertree.h>
+
+#include <QtTest>
+
+using namespace ampc;
+
+namespace {
+
+std::vector<uint32_t> smallPrimes(const size_t count) {
+    std::vector<uint32_t> primes;
+    for (uint32_t p = 2; primes.size() < count; ++p) {
+        if (Primes::getInstance().isPrime(p)) primes.push_back(p);
+    }
+    return primes;
+}
+
+Integer candidate() {
+    Integer x(3);
+    x.power(Integer(40000));
+    return x + 2;
+}
+
+}
+
+void RemainderTreeTest::wordRemaindersTest() {
+    const std::vector<uint32_t> moduli = smallPrimes(1003);
+    const Integer x("-123456789012345678901234567890123456789012345678901234567890");
+
+    std::vector<uint32_t> result;
+    x.remainders(moduli, result);
+
+    QVERIFY(result.size() == moduli.size());
+    for (size_t s = 0; s < moduli.size(); ++s) {
+        QVERIFY(Integer(result[s]) == x % Integer(moduli[s]));
+    }
+
+    Integer(0).remainders(moduli, result);
+    QVERIFY(result == std::vector<uint32_t>(moduli.size(), 0));
+}
+
+void RemainderTreeTest::treeTest() {
+    const std::vector<uint32_t> moduli = smallPrimes(777);
+    RemainderTree tree(moduli);
+
+    const Integer x = candidate();
+    std::vector<uint32_t> expected, result;
+    x.remainders(moduli, expected);
+    tree.remainders(x, result);
+    QVERIFY(result == expected);
+
+    (-x).remainders(moduli, expected);
+    tree.remainders(-x, result);
+    QVERIFY(result == expected);
+
+    RemainderTree single(std::vector<uint32_t>{97});
+    single.remainders(Integer(1000), result);
+    QVERIFY(result == std::vector<uint32_t>{1000 % 97});
+}
+
+void RemainderTreeTest::largeModuliTest() {
+    std::vector<Integer> moduli;
+    for (uint32_t i = 0; i < 50; ++i) {
+        Integer m(10);
+        moduli.push_back(m.power(Integer(30 + i)) + Integer(2 * i + 1));
+    }
+    RemainderTree tree(moduli);
+
+    const Integer x = candidate();
+    std::vector<Integer> result;
+    tree.remainders(x, result);
+
+    QVERIFY(result.size() == moduli.size());
+    for (size_t s = 0; s < moduli.size(); ++s) QVERIFY(result[s] == x % moduli[s]);
+}
+
+void RemainderTreeTest::performanceSingleRemaindersTest() {
+    const std::vector<uint32_t> moduli = smallPrimes(2000);
+    const Integer x = candidate();
+    std::vector<uint32_t> result(moduli.size());
+
+    QBENCHMARK {
+        for (size_t s = 0; s < moduli.size(); ++s) result[s] = x % moduli[s];
+    }
+}
+
+void RemainderTreeTest::performanceWordRemaindersTest() {
+    const std::vector<uint32_t> moduli = smallPrimes(2000);
+    const Integer x = candidate();
+    std::vector<uint32_t> result;
+
+    QBENCHMARK {
+        x.remainders(moduli, result);
+    }
+}
+
+void RemainderTreeTest::performanceTreeRemaindersTest() {
+    const std::vector<uint32_t> moduli = smallPrimes(2000);
+    const Integer x = candidate();
+    RemainderTree tree(moduli);
+    std::vector<uint32_t> result;
+
+    QBENCHMARK {
+        tree.remainders(x, result);
+    }
+}